@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <string>
+
+namespace engine {
+
+// FNV-1a over a path named the way AssetPack::normalize names it: '\'
+// read as '/', leading "../" and "./" skipped. constexpr so ids spelled as
+// literals are hashed by the compiler
+constexpr bool isSeparator(char c) { return c == '/' || c == '\\'; }
+
+constexpr const char* skipRelative(const char* path) {
+  return path[0] == '.' && path[1] == '.' && isSeparator(path[2])
+             ? skipRelative(path + 3)
+         : path[0] == '.' && isSeparator(path[1]) ? skipRelative(path + 2)
+                                                  : path;
+}
+
+constexpr Uint64 hashName(const char* name, Uint64 hash) {
+  return *name == '\0'
+             ? hash
+             : hashName(name + 1,
+                        (hash ^ static_cast<unsigned char>(
+                                    *name == '\\' ? '/' : *name)) *
+                            0x100000001b3ull);
+}
+
+constexpr Uint64 hashPath(const char* path) {
+  return hashName(skipRelative(path), 0xcbf29ce484222325ull);
+}
+
+// names an asset by the hash of its path, which is what the loaders,
+// packs and registries key on, so looking one up is an integer compare.
+// the path itself is only borrowed for opening the file and for error
+// messages, so ids are meant to be made from literals
+class AssetId {
+ public:
+  constexpr AssetId() : m_hash{0}, m_path{""} {}
+  constexpr AssetId(const char* path) : m_hash{hashPath(path)}, m_path{path} {}
+  // borrows path.c_str(): the string has to outlive the id and stay
+  // unmodified, so never pass a temporary. explicit so that is never done
+  // by accident
+  explicit AssetId(const std::string& path) : AssetId{path.c_str()} {}
+
+  constexpr bool operator==(const AssetId& other) const {
+    return m_hash == other.m_hash;
+  }
+  constexpr bool operator!=(const AssetId& other) const {
+    return m_hash != other.m_hash;
+  }
+
+  // getters
+  constexpr Uint64 hash() const { return m_hash; }
+  constexpr const char* path() const { return m_path; }
+
+ private:
+  Uint64 m_hash;
+  const char* m_path;
+};
+
+// for unordered containers keyed by AssetId::hash(), already well mixed
+struct AssetIdHash {
+  size_t operator()(Uint64 hash) const { return static_cast<size_t>(hash); }
+};
+
+// whether two paths name the same asset, compared the way they are hashed
+constexpr bool sameName(const char* a, const char* b) {
+  return (*a == '\\' ? '/' : *a) != (*b == '\\' ? '/' : *b)
+             ? false
+             : *a == '\0' || sameName(a + 1, b + 1);
+}
+
+constexpr bool samePath(const char* a, const char* b) {
+  return sameName(skipRelative(a), skipRelative(b));
+}
+
+namespace literals {
+// "../img/button.png"_asset
+constexpr AssetId operator"" _asset(const char* path, size_t) {
+  return AssetId{path};
+}
+}  // namespace literals
+
+// true when no two of the ids share a hash, for a static_assert over
+// every asset a program knows of
+constexpr bool hashDiffers(const AssetId* ids, size_t count, Uint64 hash) {
+  return count == 0 ||
+         (ids->hash() != hash && hashDiffers(ids + 1, count - 1, hash));
+}
+
+constexpr bool uniqueIds(const AssetId* ids, size_t count) {
+  return count == 0 || (hashDiffers(ids + 1, count - 1, ids->hash()) &&
+                        uniqueIds(ids + 1, count - 1));
+}
+
+template <size_t N>
+constexpr bool uniqueIds(const AssetId (&ids)[N]) {
+  return uniqueIds(ids, N);
+}
+
+}  // namespace engine
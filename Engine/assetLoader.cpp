@@ -0,0 +1,225 @@
+#include "assetLoader.h"
+
+#include <memory>
+#include <utility>
+
+#include "media.h"
+#include "textureCache.h"
+
+namespace engine {
+
+AssetLoader::AssetLoader(unsigned threads) {
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  if (threads == 0) threads = 2;
+
+  for (unsigned i{0}; i < threads; i++) {
+    m_threads.emplace_back(&AssetLoader::work, this);
+  }
+}
+
+AssetLoader::~AssetLoader() {
+  // workers drain whatever is queued before they exit; uploads never run
+  // after this point, so their futures report a broken promise
+  {
+    std::lock_guard<std::mutex> lock{m_jobMutex};
+    m_stopping = true;
+  }
+  m_jobReady.notify_all();
+
+  for (std::thread& thread : m_threads) thread.join();
+}
+
+void AssetLoader::work() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock{m_jobMutex};
+      m_jobReady.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+      if (m_jobs.empty()) return;
+
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+    job();
+  }
+}
+
+void AssetLoader::enqueue(std::function<void()> job) {
+  m_total++;
+  {
+    std::lock_guard<std::mutex> lock{m_jobMutex};
+    m_jobs.push_back(std::move(job));
+  }
+  m_jobReady.notify_one();
+}
+
+void AssetLoader::upload(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock{m_uploadMutex};
+    m_uploads.push_back(std::move(job));
+  }
+  m_progress.notify_all();
+}
+
+void AssetLoader::complete() {
+  {
+    std::lock_guard<std::mutex> lock{m_uploadMutex};
+    m_finished++;
+  }
+  m_progress.notify_all();
+}
+
+template <typename T>
+std::future<T> AssetLoader::decode(std::function<T()> work) {
+  std::shared_ptr<std::promise<T>> promise{
+      std::make_shared<std::promise<T>>()};
+  std::future<T> result{promise->get_future()};
+
+  enqueue([this, promise, work] {
+    promise->set_value(work());
+    complete();
+  });
+
+  return result;
+}
+
+// ids only borrow their path, so jobs copy it and hash again on the worker
+std::future<SurfaceHandle> AssetLoader::loadImage(AssetId asset) {
+  std::string path{asset.path()};
+  return decode<SurfaceHandle>(
+      [path] { return engine::loadImage(AssetId{path}); });
+}
+
+std::future<FontHandle> AssetLoader::loadFont(AssetId asset, int pointSize) {
+  std::string path{asset.path()};
+  return decode<FontHandle>([this, path, pointSize] {
+    std::lock_guard<std::mutex> lock{m_fontMutex};
+    return engine::loadFont(AssetId{path}, pointSize);
+  });
+}
+
+std::future<ChunkHandle> AssetLoader::loadChunk(AssetId asset) {
+  std::string path{asset.path()};
+  return decode<ChunkHandle>(
+      [path] { return engine::loadChunk(AssetId{path}); });
+}
+
+std::future<MusicHandle> AssetLoader::loadMusic(AssetId asset) {
+  std::string path{asset.path()};
+  return decode<MusicHandle>(
+      [path] { return engine::loadMusic(AssetId{path}); });
+}
+
+std::future<Texture> AssetLoader::loadTexture(SDL_Renderer* renderer,
+                                              AssetId asset) {
+  std::string path{asset.path()};
+  std::shared_ptr<std::promise<Texture>> promise{
+      std::make_shared<std::promise<Texture>>()};
+  std::future<Texture> result{promise->get_future()};
+
+  // the renderer is only asked on this thread
+  Uint32 format{preferredFormat(renderer)};
+
+  enqueue([this, promise, renderer, path, format] {
+    std::shared_ptr<SDL_Surface> surface{
+        loadCachedImage(AssetId{path}, format).release(), SurfaceDeleter{}};
+    if (!surface) {
+      promise->set_value(Texture{});
+      complete();
+      return;
+    }
+
+    // textures belong to the renderer's thread
+    upload([this, promise, renderer, surface] {
+      Texture texture;
+      texture.loadSurface(renderer, surface.get());
+      promise->set_value(std::move(texture));
+      complete();
+    });
+  });
+
+  return result;
+}
+
+LazyTexture AssetLoader::requestTexture(SDL_Renderer* renderer,
+                                        AssetId asset, bool mipmapped,
+                                        int width, int height) {
+  std::shared_ptr<LazyTexture::State> state{
+      std::make_shared<LazyTexture::State>()};
+  state->placeholder = m_placeholder;
+  state->width = width;
+  state->height = height;
+
+  std::string path{asset.path()};
+  Uint32 format{preferredFormat(renderer)};
+
+  enqueue([this, state, renderer, path, format, mipmapped] {
+    std::shared_ptr<SDL_Surface> surface{
+        loadCachedImage(AssetId{path}, format).release(), SurfaceDeleter{}};
+    if (!surface) {
+      state->status.store(LazyTexture::load_failed,
+                          std::memory_order_release);
+      complete();
+      return;
+    }
+
+    // uploaded aside and published in one store, so drawing never sees a
+    // half made texture
+    upload([this, state, renderer, surface, mipmapped] {
+      Texture texture;
+      if (texture.loadSurface(renderer, surface.get(), mipmapped)) {
+        state->texture = std::move(texture);
+        state->status.store(LazyTexture::load_ready,
+                            std::memory_order_release);
+      } else {
+        state->status.store(LazyTexture::load_failed,
+                           std::memory_order_release);
+      }
+      complete();
+    });
+  });
+
+  return LazyTexture{state};
+}
+
+void AssetLoader::setPlaceholder(std::shared_ptr<const Texture> placeholder) {
+  m_placeholder = std::move(placeholder);
+}
+
+void AssetLoader::setProgressCallback(ProgressCallback callback) {
+  m_callback = std::move(callback);
+}
+
+void AssetLoader::update() {
+  {
+    std::lock_guard<std::mutex> lock{m_uploadMutex};
+    m_running.swap(m_uploads);
+  }
+  for (std::function<void()>& job : m_running) job();
+  m_running.clear();
+
+  int finished{m_finished};
+  if (m_callback && finished != m_reported) {
+    m_reported = finished;
+    m_callback(finished, m_total);
+  }
+}
+
+void AssetLoader::finish() {
+  for (;;) {
+    bool done{false};
+    {
+      std::unique_lock<std::mutex> lock{m_uploadMutex};
+      m_progress.wait(lock, [this] {
+        return !m_uploads.empty() || m_finished == m_total;
+      });
+      done = m_uploads.empty() && m_finished == m_total;
+    }
+
+    // run once more when done so the final count is reported
+    update();
+    if (done) return;
+  }
+}
+
+}  // namespace engine
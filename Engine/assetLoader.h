@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assetId.h"
+#include "handles.h"
+#include "lazyTexture.h"
+#include "texture.h"
+
+namespace engine {
+
+// decodes assets on a pool of worker threads; only the steps that need the
+// renderer are queued back and run on the main thread by update(). every
+// load returns a future that holds an empty handle if loading failed.
+// the workers keep their own copy of each asset's path
+class AssetLoader {
+ public:
+  // finished and total loads queued so far, called from update()
+  using ProgressCallback = std::function<void(int finished, int total)>;
+
+  // 0 threads means one per core
+  explicit AssetLoader(unsigned threads = 0);
+  ~AssetLoader();
+
+  AssetLoader(const AssetLoader&) = delete;
+  AssetLoader& operator=(const AssetLoader&) = delete;
+
+  std::future<SurfaceHandle> loadImage(AssetId asset);
+  std::future<FontHandle> loadFont(AssetId asset, int pointSize);
+  std::future<ChunkHandle> loadChunk(AssetId asset);
+  std::future<MusicHandle> loadMusic(AssetId asset);
+
+  // decoded (or read from the texture cache) and keyed like
+  // Texture::loadFile, uploaded by update()
+  std::future<Texture> loadTexture(SDL_Renderer* renderer, AssetId asset);
+
+  // the same without waiting: the handle can be drawn at once and shows
+  // the placeholder, at width x height if given, until update() swaps the
+  // texture in. a failed load is reported and leaves the placeholder
+  LazyTexture requestTexture(SDL_Renderer* renderer, AssetId asset,
+                             bool mipmapped = false, int width = 0,
+                             int height = 0);
+
+  // drawn by textures requested after this, null for nothing
+  void setPlaceholder(std::shared_ptr<const Texture> placeholder);
+
+  void setProgressCallback(ProgressCallback callback);
+
+  // main thread only: runs pending uploads and reports progress
+  void update();
+
+  // update() until everything queued so far has finished
+  void finish();
+
+  int getFinished() const { return m_finished; }
+  int getTotal() const { return m_total; }
+
+ private:
+  template <typename T>
+  std::future<T> decode(std::function<T()> work);
+
+  void enqueue(std::function<void()> job);
+  void upload(std::function<void()> job);
+  void complete();
+  void work();
+
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_jobMutex;
+  std::condition_variable m_jobReady;
+  std::deque<std::function<void()>> m_jobs;
+  bool m_stopping{false};
+
+  // workers hand uploads over here and signal whenever anything finishes
+  std::mutex m_uploadMutex;
+  std::condition_variable m_progress;
+  std::vector<std::function<void()>> m_uploads;
+  std::vector<std::function<void()>> m_running;
+
+  // freetype shares one library between fonts, so opening is serialized
+  std::mutex m_fontMutex;
+
+  std::atomic<int> m_finished{0};
+  int m_total{0};
+  int m_reported{0};
+  ProgressCallback m_callback;
+
+  std::shared_ptr<const Texture> m_placeholder;
+};
+
+}  // namespace engine
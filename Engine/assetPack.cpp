@@ -0,0 +1,227 @@
+#include "assetPack.h"
+
+#include <cstring>
+#include <iostream>
+
+#include "embeddedAssets.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+
+namespace {
+const AssetPack* mounted{nullptr};
+
+Uint32 readU32(const Uint8* bytes) {
+  Uint32 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE32(value);
+}
+
+Uint64 readU64(const Uint8* bytes) {
+  Uint64 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE64(value);
+}
+}  // namespace
+
+constexpr char AssetPack::magic[9];
+constexpr size_t AssetPack::alignment;
+
+AssetPack::~AssetPack() { close(); }
+
+bool AssetPack::open(const std::string& path) {
+  close();
+
+#ifdef _WIN32
+  HANDLE file{CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)};
+  if (file == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER size;
+  HANDLE mapping{NULL};
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  }
+  if (!mapping) {
+    std::cerr << "Error mapping " << path << '\n';
+    CloseHandle(file);
+    return false;
+  }
+
+  m_data = static_cast<const Uint8*>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  m_size = static_cast<size_t>(size.QuadPart);
+  m_file = file;
+  m_mapping = mapping;
+#else
+  int file{::open(path.c_str(), O_RDONLY)};
+  if (file < 0) return false;
+
+  struct stat info;
+  void* mapped{MAP_FAILED};
+  if (fstat(file, &info) == 0 && info.st_size > 0) {
+    mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                  MAP_PRIVATE, file, 0);
+  }
+  // the mapping keeps its own reference to the file
+  ::close(file);
+
+  if (mapped != MAP_FAILED) {
+    m_data = static_cast<const Uint8*>(mapped);
+    m_size = static_cast<size_t>(info.st_size);
+  }
+#endif
+
+  if (!m_data) {
+    std::cerr << "Error mapping " << path << '\n';
+    close();
+    return false;
+  }
+
+  if (!readIndex()) {
+    std::cerr << "Error reading " << path << ": not a valid asset pack\n";
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+void AssetPack::close() {
+  if (mounted == this) mounted = nullptr;
+  m_entries.clear();
+
+#ifdef _WIN32
+  if (m_data) UnmapViewOfFile(m_data);
+  if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+  if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+  m_mapping = nullptr;
+  m_file = nullptr;
+#else
+  if (m_data) munmap(const_cast<Uint8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool AssetPack::readIndex() {
+  const size_t magicLength{sizeof(magic) - 1};
+  if (m_size < magicLength + 4) return false;
+  if (std::memcmp(m_data, magic, magicLength) != 0) return false;
+
+  Uint32 count{readU32(m_data + magicLength)};
+  size_t cursor{magicLength + 4};
+
+  m_entries.reserve(count);
+  for (Uint32 i{0}; i < count; i++) {
+    if (m_size - cursor < 4) return false;
+    Uint32 nameLength{readU32(m_data + cursor)};
+    cursor += 4;
+
+    if (m_size - cursor < nameLength + 16ull) return false;
+    std::string name{reinterpret_cast<const char*>(m_data + cursor),
+                     nameLength};
+    cursor += nameLength;
+
+    Entry entry{readU64(m_data + cursor), readU64(m_data + cursor + 8)};
+    cursor += 16;
+
+    if (entry.offset > m_size || entry.size > m_size - entry.offset) {
+      return false;
+    }
+    if (!m_entries.emplace(hashPath(name.c_str()), entry).second) {
+      std::cerr << "Asset id of " << name << " is already taken\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::string AssetPack::normalize(const std::string& path) {
+  std::string name{path};
+  for (char& c : name) {
+    if (c == '\\') c = '/';
+  }
+
+  for (;;) {
+    if (name.compare(0, 3, "../") == 0) {
+      name.erase(0, 3);
+    } else if (name.compare(0, 2, "./") == 0) {
+      name.erase(0, 2);
+    } else {
+      return name;
+    }
+  }
+}
+
+bool AssetPack::contains(AssetId asset) const {
+  return m_entries.count(asset.hash()) != 0;
+}
+
+SDL_RWops* AssetPack::openEntry(AssetId asset) const {
+  auto found = m_entries.find(asset.hash());
+  if (found == m_entries.end()) return nullptr;
+
+  return SDL_RWFromConstMem(m_data + found->second.offset,
+                            static_cast<int>(found->second.size));
+}
+
+void mountPack(const AssetPack* pack) { mounted = pack; }
+
+const AssetPack* getMountedPack() { return mounted; }
+
+SDL_RWops* openAsset(AssetId asset) {
+  const EmbeddedAsset* embedded{findEmbeddedAsset(asset)};
+  if (embedded) {
+    return SDL_RWFromConstMem(embedded->data,
+                              static_cast<int>(embedded->size));
+  }
+
+  if (mounted) {
+    SDL_RWops* entry{mounted->openEntry(asset)};
+    if (entry) return entry;
+  }
+  return SDL_RWFromFile(asset.path(), "rb");
+}
+
+bool readAsset(AssetId asset, std::vector<Uint8>& bytes) {
+  SDL_RWops* source{openAsset(asset)};
+  if (!source) {
+    std::cerr << "Error loading " << asset.path() << ": " << SDL_GetError()
+              << '\n';
+    return false;
+  }
+
+  Sint64 size{SDL_RWsize(source)};
+  bytes.resize(size > 0 ? static_cast<size_t>(size) : 0);
+  size_t read{bytes.empty() ? 0 : SDL_RWread(source, bytes.data(), 1,
+                                                 bytes.size())};
+  SDL_RWclose(source);
+
+  if (size <= 0 || read != bytes.size()) {
+    std::cerr << "Error reading " << asset.path() << '\n';
+    return false;
+  }
+  return true;
+}
+
+Uint64 hashBytes(const Uint8* data, size_t size) {
+  Uint64 hash{0xcbf29ce484222325ull};
+  for (size_t i{0}; i < size; i++) {
+    hash ^= data[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+}  // namespace engine
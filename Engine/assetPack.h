@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "assetId.h"
+
+namespace engine {
+
+// read-only archive of asset files, memory-mapped so opening it is one
+// map call and entries are paged in only when something reads them.
+// layout, all integers little endian:
+//   "SDLPACK1"  count:u32
+//   count x { nameLength:u32  name  offset:u64  size:u64 }
+//   entry data, each starting on a 16 byte boundary
+// entries are looked up by the AssetId of their name, hashed once on open
+class AssetPack {
+ public:
+  AssetPack() = default;
+  ~AssetPack();
+
+  AssetPack(const AssetPack&) = delete;
+  AssetPack& operator=(const AssetPack&) = delete;
+
+  // a missing file only returns false, a malformed one (or one with two
+  // names sharing an id) is also reported
+  bool open(const std::string& path);
+  void close();
+
+  // names are paths with "../" and "./" prefixes dropped and '/' separators
+  bool contains(AssetId asset) const;
+
+  // read-only stream over one entry, valid while the pack stays open;
+  // null when the entry is not in the pack
+  SDL_RWops* openEntry(AssetId asset) const;
+
+  static std::string normalize(const std::string& path);
+
+  bool isOpen() const { return m_data != nullptr; }
+  size_t getEntryCount() const { return m_entries.size(); }
+
+  static constexpr char magic[9]{"SDLPACK1"};
+  static constexpr size_t alignment{16};
+
+ private:
+  struct Entry {
+    Uint64 offset;
+    Uint64 size;
+  };
+
+  bool readIndex();
+
+  const Uint8* m_data{nullptr};
+  size_t m_size{0};
+#ifdef _WIN32
+  void* m_file{nullptr};
+  void* m_mapping{nullptr};
+#endif
+
+  std::unordered_map<Uint64, Entry, AssetIdHash> m_entries;
+};
+
+// media loading checks the mounted pack before the file system, so
+// programs keep their relative paths whether or not a pack is present
+void mountPack(const AssetPack* pack);
+const AssetPack* getMountedPack();
+
+// the compiled-in copy of path, else the mounted pack's entry, else a
+// plain file stream
+SDL_RWops* openAsset(AssetId asset);
+
+// the whole asset read into bytes; failures are reported to std::cerr
+bool readAsset(AssetId asset, std::vector<Uint8>& bytes);
+
+// FNV-1a over the bytes, enough to tell files apart but not cryptographic
+Uint64 hashBytes(const Uint8* data, size_t size);
+
+}  // namespace engine
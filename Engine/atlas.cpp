@@ -0,0 +1,299 @@
+#include "atlas.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "media.h"
+
+namespace engine {
+
+AtlasPacker::AtlasPacker(int width, int height, int padding)
+    : m_width{width}, m_height{height}, m_padding{padding} {
+  reset();
+}
+
+void AtlasPacker::reset() {
+  m_skyline.clear();
+  m_skyline.push_back(Segment{0, 0, m_width});
+}
+
+int AtlasPacker::fit(size_t index, int width, int height) const {
+  int x{m_skyline[index].x};
+  if (x + width > m_width) return -1;
+
+  int y{m_skyline[index].y};
+  int widthLeft{width};
+
+  for (size_t i{index}; widthLeft > 0; i++) {
+    if (i == m_skyline.size()) return -1;
+    y = std::max(y, m_skyline[i].y);
+    if (y + height > m_height) return -1;
+    widthLeft -= m_skyline[i].width;
+  }
+
+  return y;
+}
+
+bool AtlasPacker::insert(int width, int height, SDL_Point& position) {
+  if (width <= 0 || height <= 0) return false;
+
+  int bestIndex{-1};
+  int bestBottom{m_height + 1};
+  int bestWidth{m_width + 1};
+
+  // lowest resting place wins, narrower segment breaks ties
+  for (size_t i{0}; i < m_skyline.size(); i++) {
+    int y{fit(i, width, height)};
+    if (y < 0) continue;
+
+    int bottom{y + height};
+    if (bottom < bestBottom ||
+        (bottom == bestBottom && m_skyline[i].width < bestWidth)) {
+      bestIndex = static_cast<int>(i);
+      bestBottom = bottom;
+      bestWidth = m_skyline[i].width;
+      position.x = m_skyline[i].x;
+      position.y = y;
+    }
+  }
+
+  if (bestIndex < 0) return false;
+
+  Segment placed{position.x, position.y + height + m_padding,
+                 std::min(width + m_padding, m_width - position.x)};
+  m_skyline.insert(m_skyline.begin() + bestIndex, placed);
+
+  // trim the segments the new one now covers
+  for (size_t i = bestIndex + 1; i < m_skyline.size();) {
+    int coveredTo{m_skyline[i - 1].x + m_skyline[i - 1].width};
+    if (m_skyline[i].x >= coveredTo) break;
+
+    int shrink{coveredTo - m_skyline[i].x};
+    m_skyline[i].x += shrink;
+    m_skyline[i].width -= shrink;
+
+    if (m_skyline[i].width > 0) break;
+    m_skyline.erase(m_skyline.begin() + i);
+  }
+
+  // merge neighbours at the same height
+  for (size_t i{0}; i + 1 < m_skyline.size();) {
+    if (m_skyline[i].y == m_skyline[i + 1].y) {
+      m_skyline[i].width += m_skyline[i + 1].width;
+      m_skyline.erase(m_skyline.begin() + i + 1);
+    } else {
+      i++;
+    }
+  }
+
+  return true;
+}
+
+Atlas::Atlas(int pageSize) : m_pageSize{pageSize} {}
+
+int Atlas::addFile(AssetId asset, const std::string& name) {
+  SurfaceHandle surface{applyColorKey(loadImage(asset))};
+  if (!surface) return -1;
+
+  if (!name.empty()) return addSurface(name, std::move(surface));
+
+  const std::string path{asset.path()};
+  size_t slash{path.find_last_of("/\\")};
+  return addSurface(slash == std::string::npos ? path : path.substr(slash + 1),
+                    std::move(surface));
+}
+
+int Atlas::addSurface(const std::string& name, SurfaceHandle surface) {
+  if (!surface) return -1;
+
+  if (surface->w > m_pageSize || surface->h > m_pageSize) {
+    std::cerr << "Atlas: " << name << " is larger than a " << m_pageSize
+              << " page\n";
+    return -1;
+  }
+
+  AtlasRegion region;
+  region.name = name;
+  region.rect = SDL_Rect{0, 0, surface->w, surface->h};
+
+  m_regions.push_back(region);
+  m_sources.push_back(std::move(surface));
+  return static_cast<int>(m_regions.size()) - 1;
+}
+
+bool Atlas::pack() {
+  std::vector<size_t> order;
+  for (size_t i{0}; i < m_sources.size(); i++) {
+    if (m_sources[i]) order.push_back(i);
+  }
+
+  // tall images first keeps the skyline flat
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (m_sources[a]->h != m_sources[b]->h) {
+      return m_sources[a]->h > m_sources[b]->h;
+    }
+    return m_sources[a]->w > m_sources[b]->w;
+  });
+
+  std::vector<AtlasPacker> packers;
+
+  for (size_t index : order) {
+    SDL_Surface* source{m_sources[index].get()};
+    AtlasRegion& region{m_regions[index]};
+    SDL_Point position{};
+
+    size_t page{0};
+    while (page < packers.size() &&
+           !packers[page].insert(source->w, source->h, position)) {
+      page++;
+    }
+
+    if (page == packers.size()) {
+      packers.push_back(AtlasPacker{m_pageSize, m_pageSize});
+      m_pageSurfaces.push_back(SurfaceHandle{SDL_CreateRGBSurfaceWithFormat(
+          0, m_pageSize, m_pageSize, 32, SDL_PIXELFORMAT_ARGB8888)});
+
+      if (!m_pageSurfaces.back()) {
+        std::cerr << "Error creating atlas page: " << SDL_GetError() << '\n';
+        return false;
+      }
+
+      if (!packers.back().insert(source->w, source->h, position)) {
+        return false;
+      }
+    }
+
+    region.page = static_cast<int>(page);
+    region.rect.x = position.x;
+    region.rect.y = position.y;
+
+    // copy, not blend, so alpha lands untouched and keyed pixels stay clear
+    SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(source, NULL, m_pageSurfaces[page].get(), &region.rect);
+  }
+
+  m_sources.clear();
+  return true;
+}
+
+bool Atlas::upload(SDL_Renderer* renderer) {
+  m_pages.clear();
+  m_pages.resize(m_pageSurfaces.size());
+
+  for (size_t i{0}; i < m_pageSurfaces.size(); i++) {
+    if (!m_pages[i].loadSurface(renderer, m_pageSurfaces[i].get())) {
+      return false;
+    }
+    m_pages[i].setBlendMode(SDL_BLENDMODE_BLEND);
+  }
+
+  m_pageSurfaces.clear();
+  return true;
+}
+
+bool Atlas::save(const std::string& base) const {
+  size_t slash{base.find_last_of("/\\")};
+  std::string stem{slash == std::string::npos ? base : base.substr(slash + 1)};
+
+  std::ofstream index{base + ".atlas"};
+  if (!index) {
+    std::cerr << "Error writing " << base << ".atlas\n";
+    return false;
+  }
+
+  for (size_t i{0}; i < m_pageSurfaces.size(); i++) {
+    std::string file{stem + "_" + std::to_string(i) + ".png"};
+    std::string path{base + "_" + std::to_string(i) + ".png"};
+
+    if (IMG_SavePNG(m_pageSurfaces[i].get(), path.c_str()) != 0) {
+      std::cerr << "Error writing " << path << ": " << IMG_GetError() << '\n';
+      return false;
+    }
+    index << "page " << file << '\n';
+  }
+
+  for (const AtlasRegion& region : m_regions) {
+    index << "region " << region.name << ' ' << region.page << ' '
+          << region.rect.x << ' ' << region.rect.y << ' ' << region.rect.w
+          << ' ' << region.rect.h << '\n';
+  }
+
+  return true;
+}
+
+bool Atlas::loadFile(SDL_Renderer* renderer, const std::string& indexPath) {
+  clear();
+
+  std::ifstream index{indexPath};
+  if (!index) {
+    std::cerr << "Error opening atlas " << indexPath << '\n';
+    return false;
+  }
+
+  size_t slash{indexPath.find_last_of("/\\")};
+  std::string directory{
+      slash == std::string::npos ? "" : indexPath.substr(0, slash + 1)};
+
+  std::string line;
+  while (std::getline(index, line)) {
+    std::istringstream fields{line};
+    std::string kind;
+    fields >> kind;
+
+    if (kind == "page") {
+      std::string file;
+      fields >> file;
+
+      std::string pagePath{directory + file};
+      SurfaceHandle page{loadImage(AssetId{pagePath})};
+      if (!page) return false;
+
+      m_pages.push_back(Texture{});
+      if (!m_pages.back().loadSurface(renderer, page.get())) return false;
+      m_pages.back().setBlendMode(SDL_BLENDMODE_BLEND);
+    } else if (kind == "region") {
+      AtlasRegion region;
+      fields >> region.name >> region.page >> region.rect.x >> region.rect.y >>
+          region.rect.w >> region.rect.h;
+
+      if (!fields || region.page < 0 ||
+          region.page >= static_cast<int>(m_pages.size())) {
+        std::cerr << "Bad atlas entry in " << indexPath << ": " << line
+                  << '\n';
+        return false;
+      }
+      m_regions.push_back(region);
+    }
+  }
+
+  return true;
+}
+
+void Atlas::clear() {
+  m_regions.clear();
+  m_sources.clear();
+  m_pageSurfaces.clear();
+  m_pages.clear();
+}
+
+int Atlas::find(const std::string& name) const {
+  for (size_t i{0}; i < m_regions.size(); i++) {
+    if (m_regions[i].name == name) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+SDL_Rect Atlas::clip(int id, const SDL_Rect& local) const {
+  const SDL_Rect& rect{m_regions[id].rect};
+  return SDL_Rect{rect.x + local.x, rect.y + local.y, local.w, local.h};
+}
+
+int Atlas::getPageCount() const {
+  return static_cast<int>(std::max(m_pages.size(), m_pageSurfaces.size()));
+}
+
+}  // namespace engine
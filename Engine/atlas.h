@@ -0,0 +1,96 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <vector>
+
+#include "assetId.h"
+#include "handles.h"
+#include "texture.h"
+
+namespace engine {
+
+// skyline bottom-left rectangle packer for a single page
+class AtlasPacker {
+ public:
+  AtlasPacker(int width, int height, int padding = 1);
+
+  // finds room for a width x height rectangle, false when the page is full
+  bool insert(int width, int height, SDL_Point& position);
+  void reset();
+
+  int getWidth() const { return m_width; }
+  int getHeight() const { return m_height; }
+
+ private:
+  struct Segment {
+    int x;
+    int y;
+    int width;
+  };
+
+  // lowest y a rectangle starting at segment index would rest on, or -1
+  int fit(size_t index, int width, int height) const;
+
+  std::vector<Segment> m_skyline;
+  int m_width{};
+  int m_height{};
+  int m_padding{};
+};
+
+struct AtlasRegion {
+  std::string name;
+  int page{-1};
+  SDL_Rect rect{};
+};
+
+// packs many images into a few shared pages so a scene binds fewer textures
+class Atlas {
+ public:
+  explicit Atlas(int pageSize = 1024);
+
+  // queue an image (cyan keyed out), returns its id; name defaults to the
+  // file name so prebuilt and runtime atlases can be looked up the same way
+  int addFile(AssetId asset, const std::string& name = "");
+  int addSurface(const std::string& name, SurfaceHandle surface);
+
+  // packs everything queued into page surfaces, largest images first
+  bool pack();
+
+  // creates one texture per packed page and drops the page surfaces
+  bool upload(SDL_Renderer* renderer);
+
+  bool build(SDL_Renderer* renderer) { return pack() && upload(renderer); }
+
+  // writes the packed pages as <base>_<n>.png plus an index at <base>.atlas
+  bool save(const std::string& base) const;
+
+  // loads an atlas written by save() or the atlasPacker tool
+  bool loadFile(SDL_Renderer* renderer, const std::string& indexPath);
+
+  void clear();
+
+  // -1 when no region has that name
+  int find(const std::string& name) const;
+
+  const AtlasRegion& region(int id) const { return m_regions[id]; }
+  Texture& page(int index) { return m_pages[index]; }
+  Texture& texture(int id) { return m_pages[m_regions[id].page]; }
+
+  // maps a rectangle inside the original image to page coordinates
+  SDL_Rect clip(int id, const SDL_Rect& local) const;
+
+  int getPageSize() const { return m_pageSize; }
+  int getPageCount() const;
+  int getRegionCount() const { return static_cast<int>(m_regions.size()); }
+
+ private:
+  int m_pageSize{};
+  std::vector<AtlasRegion> m_regions;
+  std::vector<SurfaceHandle> m_sources;
+  std::vector<SurfaceHandle> m_pageSurfaces;
+  std::vector<Texture> m_pages;
+};
+
+}  // namespace engine
@@ -0,0 +1,250 @@
+#include "audioMixer.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "mixOps.h"
+
+namespace engine {
+
+constexpr int AudioMixer::maxVoices;
+constexpr int AudioMixer::blockFrames;
+
+AudioMixer::~AudioMixer() { close(); }
+
+bool AudioMixer::open() {
+  close();
+
+  int frequency{0};
+  Uint16 format{0};
+  int channels{0};
+  if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+    std::cerr << "Error opening mixer: " << Mix_GetError() << '\n';
+    return false;
+  }
+  if (format != AUDIO_S16SYS || channels != 2) {
+    std::cerr << "Error opening mixer: needs 16 bit stereo output\n";
+    return false;
+  }
+
+  m_frequency = frequency;
+  Mix_SetPostMix(&AudioMixer::callback, this);
+  m_open = true;
+  return true;
+}
+
+void AudioMixer::close() {
+  if (m_open) {
+    // returns once the callback can no longer be running
+    Mix_SetPostMix(nullptr, nullptr);
+    m_open = false;
+  }
+
+  Command command;
+  while (m_commands.pop(command)) {
+  }
+  for (int i{0}; i < maxVoices; i++) {
+    m_voices[i] = Voice{};
+    m_playing[i].store(0);
+  }
+  m_sounds.clear();
+}
+
+int AudioMixer::addSound(std::shared_ptr<Mix_Chunk> chunk) {
+  if (!chunk) return -1;
+
+  // Mix_LoadWAV converted it to the output format, whole stereo frames
+  Sound sound{chunk, reinterpret_cast<const Sint16*>(chunk->abuf),
+              static_cast<Uint32>(chunk->alen / (2 * sizeof(Sint16)))};
+  m_sounds.push_back(sound);
+  return static_cast<int>(m_sounds.size()) - 1;
+}
+
+VoiceId AudioMixer::play(int sound, float volume, bool loop, float pan) {
+  if (sound < 0 || sound >= static_cast<int>(m_sounds.size())) return 0;
+
+  const Sound& source{m_sounds[sound]};
+  Command command{command_play, m_nextVoice, source.samples, source.frames,
+                  nullptr, volume, pan, loop};
+  if (!send(command)) return 0;
+  return m_nextVoice++;
+}
+
+VoiceId AudioMixer::playStream(MusicStream& stream, float volume) {
+  Command command{command_play, m_nextVoice, nullptr, 0, &stream, volume,
+                  0.0f, false};
+  if (!send(command)) return 0;
+  return m_nextVoice++;
+}
+
+void AudioMixer::stop(VoiceId voice) { send(control(command_stop, voice)); }
+
+void AudioMixer::pause(VoiceId voice) { send(control(command_pause, voice)); }
+
+void AudioMixer::resume(VoiceId voice) {
+  send(control(command_resume, voice));
+}
+
+void AudioMixer::setVolume(VoiceId voice, float volume) {
+  Command command{control(command_volume, voice)};
+  command.volume = volume;
+  send(command);
+}
+
+void AudioMixer::setPan(VoiceId voice, float pan) {
+  Command command{control(command_pan, voice)};
+  command.pan = pan;
+  send(command);
+}
+
+void AudioMixer::setMasterVolume(float volume) {
+  Command command{control(command_masterVolume, 0)};
+  command.volume = volume;
+  send(command);
+}
+
+void AudioMixer::stopAll() { send(control(command_stopAll, 0)); }
+
+bool AudioMixer::isPlaying(VoiceId voice) const {
+  if (voice == 0) return false;
+  if (voice > m_started.load(std::memory_order_acquire)) return true;
+
+  for (int i{0}; i < maxVoices; i++) {
+    if (m_playing[i].load(std::memory_order_relaxed) == voice) return true;
+  }
+  return false;
+}
+
+AudioMixer::Command AudioMixer::control(commandType type, VoiceId voice) {
+  return Command{type, voice, nullptr, 0, nullptr, 0.0f, 0.0f, false};
+}
+
+bool AudioMixer::send(const Command& command) {
+  if (m_commands.push(command)) return true;
+  m_droppedCommands++;
+  return false;
+}
+
+void AudioMixer::callback(void* mixer, Uint8* stream, int length) {
+  AudioMixer& self{*static_cast<AudioMixer*>(mixer)};
+
+  Command command;
+  while (self.m_commands.pop(command)) self.apply(command);
+
+  const int frames{length / static_cast<int>(2 * sizeof(Sint16))};
+  Sint16* output{reinterpret_cast<Sint16*>(stream)};
+  for (int done{0}; done < frames; done += blockFrames) {
+    self.mix(output + done * 2, std::min(blockFrames, frames - done));
+  }
+}
+
+void AudioMixer::apply(const Command& command) {
+  if (command.type == command_play) {
+    Voice* slot{findVoice(0)};
+    if (!slot || (command.frames == 0 && !command.stream)) {
+      m_droppedVoices++;
+    } else {
+      *slot = Voice{};
+      slot->id = command.voice;
+      slot->samples = command.samples;
+      slot->frames = command.frames;
+      slot->stream = command.stream;
+      slot->volume = command.volume;
+      slot->pan = command.pan;
+      slot->loop = command.loop;
+      if (slot->stream) slot->stream->attach();
+      m_playing[slot - m_voices].store(command.voice,
+                                       std::memory_order_relaxed);
+    }
+    m_started.store(command.voice, std::memory_order_release);
+    return;
+  }
+
+  if (command.type == command_masterVolume) {
+    m_masterVolume = command.volume;
+    return;
+  }
+  if (command.type == command_stopAll) {
+    for (Voice& voice : m_voices) {
+      if (voice.id != 0) release(voice);
+    }
+    return;
+  }
+
+  Voice* voice{findVoice(command.voice)};
+  if (!voice || command.voice == 0) return;
+  switch (command.type) {
+    case command_stop:
+      release(*voice);
+      break;
+    case command_pause:
+      voice->paused = true;
+      break;
+    case command_resume:
+      voice->paused = false;
+      break;
+    case command_volume:
+      voice->volume = command.volume;
+      break;
+    case command_pan:
+      voice->pan = command.pan;
+      break;
+    default:
+      break;
+  }
+}
+
+AudioMixer::Voice* AudioMixer::findVoice(VoiceId id) {
+  for (Voice& voice : m_voices) {
+    if (voice.id == id) return &voice;
+  }
+  return nullptr;
+}
+
+void AudioMixer::release(Voice& voice) {
+  if (voice.stream) voice.stream->detach();
+  m_playing[&voice - m_voices].store(0, std::memory_order_relaxed);
+  voice = Voice{};
+}
+
+void AudioMixer::mix(Sint16* output, int frames) {
+  std::fill(m_scratch, m_scratch + frames * 2, 0.0f);
+
+  for (Voice& voice : m_voices) {
+    if (voice.id == 0 || voice.paused) continue;
+
+    // balance rather than constant power, so a centred voice is unchanged
+    const float pan{std::min(std::max(voice.pan, -1.0f), 1.0f)};
+    const float left{voice.volume * std::min(1.0f, 1.0f - pan)};
+    const float right{voice.volume * std::min(1.0f, 1.0f + pan)};
+
+    if (voice.stream) {
+      int count{voice.stream->read(m_streamed, frames)};
+      mixVoice(m_scratch, m_streamed, count, left, right);
+      if (count < frames && voice.stream->isFinished()) release(voice);
+      continue;
+    }
+
+    int written{0};
+    while (written < frames) {
+      const int count{static_cast<int>(std::min<Uint32>(
+          frames - written, voice.frames - voice.position))};
+      mixVoice(m_scratch + written * 2, voice.samples + voice.position * 2,
+               count, left, right);
+
+      written += count;
+      voice.position += count;
+      if (voice.position < voice.frames) continue;
+      if (!voice.loop) {
+        release(voice);
+        break;
+      }
+      voice.position = 0;
+    }
+  }
+
+  // on top of whatever SDL_mixer itself played
+  saturateS16(output, m_scratch, frames * 2, m_masterVolume);
+}
+
+}  // namespace engine
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "musicStream.h"
+#include "spscQueue.h"
+
+namespace engine {
+
+// a voice started by AudioMixer::play(), 0 is never one
+using VoiceId = Uint32;
+
+// mixes sounds inside SDL_mixer's audio callback (as its post mix hook)
+// instead of on SDL_mixer channels. the game thread only ever pushes
+// commands onto a lock-free queue that the callback drains at the start
+// of each buffer, so starting, stopping or changing a sound never waits
+// on the audio lock and always takes effect at the next buffer. needs the
+// mixer subsystem opened as the Context does: 16 bit stereo.
+// everything here is for the game thread only
+class AudioMixer {
+ public:
+  // voices playing at once, further plays are dropped and counted
+  static constexpr int maxVoices{256};
+
+  AudioMixer() = default;
+  ~AudioMixer();
+
+  AudioMixer(const AudioMixer&) = delete;
+  AudioMixer& operator=(const AudioMixer&) = delete;
+
+  // installs the callback, after Context::init
+  bool open();
+  // removes it, silencing every voice; sounds are released after
+  void close();
+
+  // keeps the chunk alive until close() and returns the id play() takes,
+  // or -1 for a null chunk
+  int addSound(std::shared_ptr<Mix_Chunk> chunk);
+
+  // volume from 0 to 1, pan from -1 (left) to 1 (right); a looping voice
+  // plays until stopped. returns 0 when the command queue is full
+  VoiceId play(int sound, float volume = 1.0f, bool loop = false,
+               float pan = 0.0f);
+
+  // plays the stream until it ends (or for ever when it loops); the
+  // stream has to stay open for as long as the voice plays
+  VoiceId playStream(MusicStream& stream, float volume = 1.0f);
+
+  // commands for voices that have already finished are ignored
+  void stop(VoiceId voice);
+  void pause(VoiceId voice);
+  void resume(VoiceId voice);
+  void setVolume(VoiceId voice, float volume);
+  void setPan(VoiceId voice, float pan);
+
+  void setMasterVolume(float volume);
+  void stopAll();
+
+  // true until the voice ends or is stopped, including while its play
+  // command is still queued
+  bool isPlaying(VoiceId voice) const;
+
+  // getters
+  int getFrequency() const { return m_frequency; }
+  // commands lost to a full queue and plays lost to a full voice table
+  int getDroppedCommands() const { return m_droppedCommands; }
+  int getDroppedVoices() const { return m_droppedVoices.load(); }
+
+ private:
+  enum commandType {
+    command_play,
+    command_stop,
+    command_pause,
+    command_resume,
+    command_volume,
+    command_pan,
+    command_masterVolume,
+    command_stopAll
+  };
+
+  struct Command {
+    commandType type;
+    VoiceId voice;
+    const Sint16* samples;
+    Uint32 frames;
+    MusicStream* stream;
+    float volume;
+    float pan;
+    bool loop;
+  };
+
+  struct Sound {
+    std::shared_ptr<Mix_Chunk> chunk;
+    const Sint16* samples;
+    Uint32 frames;
+  };
+
+  // audio thread only, id 0 marks a free slot
+  struct Voice {
+    VoiceId id{0};
+    const Sint16* samples{nullptr};
+    Uint32 frames{0};
+    Uint32 position{0};
+    // read a buffer at a time instead of samples
+    MusicStream* stream{nullptr};
+    float volume{1.0f};
+    float pan{0.0f};
+    bool loop{false};
+    bool paused{false};
+  };
+
+  // frames mixed per pass, so the scratch buffer needs no allocation
+  static constexpr int blockFrames{256};
+
+  // a command with no samples, for a voice already playing
+  static Command control(commandType type, VoiceId voice);
+  bool send(const Command& command);
+
+  static void callback(void* mixer, Uint8* stream, int length);
+  void apply(const Command& command);
+  Voice* findVoice(VoiceId id);
+  void release(Voice& voice);
+  void mix(Sint16* output, int frames);
+
+  bool m_open{false};
+  int m_frequency{0};
+
+  // game thread state
+  std::vector<Sound> m_sounds;
+  VoiceId m_nextVoice{1};
+  int m_droppedCommands{0};
+
+  SpscQueue<Command, 256> m_commands;
+
+  // audio thread state, with what the game thread may read of it
+  Voice m_voices[maxVoices];
+  std::atomic<VoiceId> m_playing[maxVoices]{};
+  // the newest voice whose play command has been taken off the queue
+  std::atomic<VoiceId> m_started{0};
+  std::atomic<int> m_droppedVoices{0};
+  float m_masterVolume{1.0f};
+  float m_scratch[blockFrames * 2];
+  Sint16 m_streamed[blockFrames * 2];
+};
+
+}  // namespace engine
@@ -0,0 +1,169 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+namespace engine {
+
+namespace {
+// first frames pay for lazy uploads and caches, so they are not recorded
+constexpr int warmupFrames{10};
+
+// nearest rank percentile of sorted times
+double percentile(const std::vector<double>& sorted, double fraction) {
+  size_t rank{static_cast<size_t>(std::ceil(fraction * sorted.size()))};
+  if (rank > 0) rank--;
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+}  // namespace
+
+bool FrameBenchmark::parse(int argc, char* argv[]) {
+  m_frames = 0;
+  if (argc > 0) {
+    const char* slash{std::strrchr(argv[0], '/')};
+    const char* backslash{std::strrchr(argv[0], '\\')};
+    const char* base{std::max(slash, backslash)};
+    m_name = base ? base + 1 : argv[0];
+  }
+
+  for (int i{1}; i + 1 < argc; i++) {
+    if (std::strcmp(argv[i], "--benchmark") == 0) {
+      m_frames = std::max(0, std::atoi(argv[i + 1]));
+      if (m_frames == 0) {
+        std::cerr << "Error: --benchmark needs a frame count\n";
+      }
+    }
+  }
+
+  m_times.clear();
+  m_times.reserve(m_frames);
+  return enabled();
+}
+
+void FrameBenchmark::configure(ContextConfig& config) const {
+  if (!enabled()) return;
+
+  config.headless = true;
+  config.rendererFlags = SDL_RENDERER_SOFTWARE;
+}
+
+void FrameBenchmark::add(int frame, inputKind kind, int x, int y,
+                         Sint32 code) {
+  m_script.push_back(Input{frame, kind, x, y, code});
+  m_scriptLength = std::max(m_scriptLength, frame + 1);
+}
+
+void FrameBenchmark::addKey(int frame, SDL_Keycode key) {
+  add(frame, input_key, 0, 0, key);
+}
+
+void FrameBenchmark::addClick(int frame, int x, int y, Uint8 button) {
+  add(frame, input_click, x, y, button);
+}
+
+void FrameBenchmark::addMotion(int frame, int x, int y) {
+  add(frame, input_motion, x, y, 0);
+}
+
+void FrameBenchmark::addWheel(int frame, int y) {
+  add(frame, input_wheel, 0, y, 0);
+}
+
+void FrameBenchmark::push(SDL_Window* window, const Input& input) const {
+  SDL_Event event;
+  SDL_zero(event);
+  Uint32 windowId{window ? SDL_GetWindowID(window) : 0};
+
+  switch (input.kind) {
+    case input_key:
+      event.type = SDL_KEYDOWN;
+      event.key.windowID = windowId;
+      event.key.state = SDL_PRESSED;
+      event.key.keysym.sym = input.code;
+      event.key.keysym.scancode = SDL_GetScancodeFromKey(input.code);
+      SDL_PushEvent(&event);
+
+      event.type = SDL_KEYUP;
+      event.key.state = SDL_RELEASED;
+      SDL_PushEvent(&event);
+      return;
+
+    case input_click:
+      // warping also queues the motion event and updates the mouse state
+      if (window) SDL_WarpMouseInWindow(window, input.x, input.y);
+
+      event.type = SDL_MOUSEBUTTONDOWN;
+      event.button.windowID = windowId;
+      event.button.button = static_cast<Uint8>(input.code);
+      event.button.state = SDL_PRESSED;
+      event.button.clicks = 1;
+      event.button.x = input.x;
+      event.button.y = input.y;
+      SDL_PushEvent(&event);
+
+      event.type = SDL_MOUSEBUTTONUP;
+      event.button.state = SDL_RELEASED;
+      SDL_PushEvent(&event);
+      return;
+
+    case input_motion:
+      if (window) SDL_WarpMouseInWindow(window, input.x, input.y);
+      return;
+
+    case input_wheel:
+      event.type = SDL_MOUSEWHEEL;
+      event.wheel.windowID = windowId;
+      event.wheel.y = input.y;
+      event.wheel.direction = SDL_MOUSEWHEEL_NORMAL;
+      SDL_PushEvent(&event);
+      return;
+  }
+}
+
+bool FrameBenchmark::nextFrame(SDL_Window* window) {
+  if (!enabled()) return true;
+
+  Uint64 now{SDL_GetPerformanceCounter()};
+  if (m_frame > warmupFrames) {
+    m_times.push_back(static_cast<double>(now - m_lastCounter) * 1000.0 /
+                      SDL_GetPerformanceFrequency());
+  }
+  m_lastCounter = now;
+
+  if (m_frame >= m_frames + warmupFrames) return false;
+
+  if (m_scriptLength > 0) {
+    int scriptFrame{m_frame % m_scriptLength};
+    for (const Input& input : m_script) {
+      if (input.frame == scriptFrame) push(window, input);
+    }
+  }
+
+  m_frame++;
+  return true;
+}
+
+void FrameBenchmark::report(std::ostream& out) const {
+  if (m_times.empty()) {
+    out << m_name << ": no frames recorded\n";
+    return;
+  }
+
+  std::vector<double> sorted{m_times};
+  std::sort(sorted.begin(), sorted.end());
+
+  double total{0.0};
+  for (double time : sorted) total += time;
+
+  out << std::fixed << std::setprecision(3) << m_name << ": "
+      << sorted.size() << " frames, mean " << total / sorted.size()
+      << " ms, p50 " << percentile(sorted, 0.50) << " ms, p99 "
+      << percentile(sorted, 0.99) << " ms, min " << sorted.front()
+      << " ms, max " << sorted.back() << " ms\n";
+}
+
+}  // namespace engine
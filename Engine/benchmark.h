@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "context.h"
+
+namespace engine {
+
+// runs a main loop headless for a fixed number of frames, replaying a
+// scripted input stream, and reports how long the frames took; disabled
+// unless "--benchmark <frames>" is on the command line
+class FrameBenchmark {
+ public:
+  // true when the arguments asked for a benchmark run
+  bool parse(int argc, char* argv[]);
+
+  // headless drivers, software renderer and no vsync
+  void configure(ContextConfig& config) const;
+
+  // input for the given frame of the script, which repeats for as long as
+  // the run lasts; pointer input also moves the real cursor so
+  // SDL_GetMouseState agrees with the events
+  void addKey(int frame, SDL_Keycode key);
+  void addClick(int frame, int x, int y, Uint8 button = SDL_BUTTON_LEFT);
+  void addMotion(int frame, int x, int y);
+  void addWheel(int frame, int y);
+
+  // call at the top of every loop iteration, before polling events; times
+  // the previous frame, queues this frame's input and returns false once
+  // all frames ran. always true when not enabled
+  bool nextFrame(SDL_Window* window);
+
+  // mean, p50, p99, min and max frame time in milliseconds
+  void report(std::ostream& out) const;
+
+  bool enabled() const { return m_frames > 0; }
+
+ private:
+  enum inputKind { input_key, input_click, input_motion, input_wheel };
+
+  struct Input {
+    int frame;
+    inputKind kind;
+    int x;
+    int y;
+    Sint32 code;
+  };
+
+  void add(int frame, inputKind kind, int x, int y, Sint32 code);
+  void push(SDL_Window* window, const Input& input) const;
+
+  std::string m_name;
+  int m_frames{0};
+  int m_frame{0};
+  Uint64 m_lastCounter{0};
+
+  std::vector<Input> m_script;
+  int m_scriptLength{0};
+
+  std::vector<double> m_times;
+};
+
+}  // namespace engine
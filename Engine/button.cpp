@@ -0,0 +1,64 @@
+#include "button.h"
+
+namespace engine {
+
+Button::Button() {
+  m_position.x = 0;
+  m_position.y = 0;
+}
+
+void Button::setPosition(int x, int y) {
+  m_position.x = x;
+  m_position.y = y;
+}
+
+void Button::setSize(int width, int height) {
+  m_width = width;
+  m_height = height;
+}
+
+void Button::setSprites(Texture* sheet, const SDL_Rect* clips) {
+  m_sheet = sheet;
+  m_clips = clips;
+}
+
+void Button::render() {
+  if (!m_sheet || !m_clips) return;
+  m_sheet->render(m_position.x, m_position.y, &m_clips[m_sprite]);
+}
+
+void Button::render(SpriteBatch& batch) {
+  if (!m_sheet || !m_clips) return;
+  batch.draw(*m_sheet, m_position.x, m_position.y, &m_clips[m_sprite]);
+}
+
+void Button::render(RenderQueue& queue, Uint8 layer) {
+  if (!m_sheet || !m_clips) return;
+  queue.submit(layer, *m_sheet, m_position.x, m_position.y,
+               &m_clips[m_sprite]);
+}
+
+void Button::handleEvent(const SDL_Event* event) {
+  int x{}, y{};
+  SDL_GetMouseState(&x, &y);
+
+  if (x < m_position.x || x > m_position.x + m_width || y < m_position.y ||
+      y > m_position.y + m_height) {
+    m_sprite = mouse_out;
+    return;
+  }
+
+  switch (event->type) {
+    case SDL_MOUSEBUTTONDOWN:
+      m_sprite = mouse_down;
+      return;
+    case SDL_MOUSEBUTTONUP:
+      m_sprite = mouse_up;
+      return;
+    case SDL_MOUSEMOTION:
+      m_sprite = mouse_over;
+      return;
+  }
+}
+
+}  // namespace engine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "renderQueue.h"
+#include "spriteBatch.h"
+#include "texture.h"
+
+namespace engine {
+
+enum buttonSprite { mouse_out, mouse_over, mouse_down, mouse_up, mouse_max };
+
+// a clickable rectangle drawn from one sprite sheet, one clip per state
+class Button {
+ public:
+  Button();
+  void render();
+  void render(SpriteBatch& batch);
+  void render(RenderQueue& queue, Uint8 layer);
+  void setPosition(int x, int y);
+  void setSize(int width, int height);
+
+  // clips must hold mouse_max rectangles, neither is owned
+  void setSprites(Texture* sheet, const SDL_Rect* clips);
+
+  void handleEvent(const SDL_Event* e);
+
+ private:
+  Texture* m_sheet{nullptr};
+  const SDL_Rect* m_clips{nullptr};
+  SDL_Point m_position{};
+  int m_width{};
+  int m_height{};
+  buttonSprite m_sprite{};
+};
+
+}  // namespace engine
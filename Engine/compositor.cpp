@@ -0,0 +1,208 @@
+#include "compositor.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "pixelOps.h"
+
+namespace engine {
+
+namespace {
+// past this many rectangles one bounding box is cheaper to push
+constexpr size_t maxDirtyRects{16};
+}  // namespace
+
+Compositor::Compositor(SDL_Window* window) : m_window{window} {}
+
+void Compositor::setWindow(SDL_Window* window) {
+  m_window = window;
+  redrawAll();
+}
+
+void Compositor::draw(SDL_Surface* source, const SDL_Rect* destination,
+                      scaleFilter filter) {
+  if (!source) return;
+
+  SDL_Rect area{0, 0, 0, 0};
+  if (destination) {
+    area = *destination;
+  } else if (m_window) {
+    SDL_GetWindowSize(m_window, &area.w, &area.h);
+  }
+  if (area.w <= 0 || area.h <= 0) return;
+
+  m_draws.push_back(Draw{source, area, filter});
+}
+
+void Compositor::invalidate(SDL_Surface* source) {
+  m_cache.erase(std::remove_if(m_cache.begin(), m_cache.end(),
+                               [source](const Scaled& scaled) {
+                                 return scaled.source == source;
+                               }),
+                m_cache.end());
+
+  // stale pixels may already be on screen wherever it was drawn
+  for (Draw& draw : m_previous) {
+    if (draw.source == source) draw.source = nullptr;
+  }
+}
+
+void Compositor::redrawAll() {
+  m_target = nullptr;
+  m_previous.clear();
+}
+
+void Compositor::resetStats() {
+  m_updatedRects = 0;
+  m_scales = 0;
+}
+
+SDL_Surface* Compositor::prepare(const Draw& draw,
+                                 const SDL_PixelFormat* format) {
+  SDL_Surface* source{draw.source};
+  bool stretched{source->w != draw.destination.w ||
+                 source->h != draw.destination.h};
+  if (!stretched) return source;
+
+  for (const Scaled& scaled : m_cache) {
+    if (scaled.serves(draw)) return scaled.surface.get();
+  }
+
+  // what the copy has to draw like, read before anything touches source
+  SDL_BlendMode blending{SDL_BLENDMODE_NONE};
+  SDL_GetSurfaceBlendMode(draw.source, &blending);
+
+  SurfaceHandle converted;
+  if (source->format->format != format->format) {
+    converted.reset(SDL_ConvertSurface(source, format, 0));
+    if (!converted) {
+      std::cerr << "Error converting surface: " << SDL_GetError() << '\n';
+      return nullptr;
+    }
+    source = converted.get();
+  }
+
+  // in source's format, which conversion maps the key into
+  Uint32 key{0};
+  bool keyed{SDL_GetColorKey(source, &key) == 0};
+
+  SurfaceHandle scaled{SDL_CreateRGBSurfaceWithFormat(
+      0, draw.destination.w, draw.destination.h, format->BitsPerPixel,
+      format->format)};
+  if (!scaled) {
+    std::cerr << "Error creating scaled surface: " << SDL_GetError() << '\n';
+    return nullptr;
+  }
+
+  if (format->BytesPerPixel == 4) {
+    SDL_LockSurface(source);
+    // blending would smear the key colour into its neighbours
+    if (draw.filter == scale_bilinear && !keyed) {
+      scaleBilinear(source, scaled.get());
+    } else {
+      scaleNearest(source, scaled.get());
+    }
+    SDL_UnlockSurface(source);
+  } else {
+    // the kernels only know 32-bit pixels. copied raw, keyed pixels
+    // included, then put back as the caller had it
+    SDL_BlendMode sourceBlending{SDL_BLENDMODE_NONE};
+    SDL_GetSurfaceBlendMode(source, &sourceBlending);
+    SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+    if (keyed) SDL_SetColorKey(source, SDL_FALSE, key);
+    SDL_BlitScaled(source, NULL, scaled.get(), NULL);
+    if (keyed) SDL_SetColorKey(source, SDL_TRUE, key);
+    SDL_SetSurfaceBlendMode(source, sourceBlending);
+  }
+
+  SDL_SetSurfaceBlendMode(scaled.get(), blending);
+  if (keyed) SDL_SetColorKey(scaled.get(), SDL_TRUE, key);
+
+  m_scales++;
+  m_cache.push_back(Scaled{draw.source, draw.destination.w,
+                           draw.destination.h, draw.filter,
+                           std::move(scaled)});
+  return m_cache.back().surface.get();
+}
+
+void Compositor::present() {
+  SDL_Surface* target{m_window ? SDL_GetWindowSurface(m_window) : nullptr};
+  if (!target) {
+    m_draws.clear();
+    return;
+  }
+
+  m_dirty.clear();
+  if (target != m_target) {
+    // a new or resized window surface has none of the old pixels
+    m_dirty.push_back(SDL_Rect{0, 0, target->w, target->h});
+    m_target = target;
+  } else {
+    size_t count{std::max(m_draws.size(), m_previous.size())};
+    for (size_t i{0}; i < count; i++) {
+      bool current{i < m_draws.size()};
+      bool previous{i < m_previous.size()};
+      if (current && previous && m_draws[i] == m_previous[i]) continue;
+      if (current) m_dirty.push_back(m_draws[i].destination);
+      if (previous &&
+          !(current && SDL_RectEquals(&m_draws[i].destination,
+                                      &m_previous[i].destination))) {
+        m_dirty.push_back(m_previous[i].destination);
+      }
+    }
+
+    if (m_dirty.size() > maxDirtyRects) {
+      SDL_Rect bounds{m_dirty[0]};
+      for (const SDL_Rect& rect : m_dirty) {
+        SDL_UnionRect(&bounds, &rect, &bounds);
+      }
+      m_dirty.assign(1, bounds);
+    }
+  }
+
+  // every draw touching a dirty rectangle is repeated inside it, in order,
+  // so overlapping surfaces still stack correctly
+  const SDL_Rect screen{0, 0, target->w, target->h};
+  std::vector<SDL_Rect> updates;
+  for (const SDL_Rect& dirty : m_dirty) {
+    SDL_Rect clip;
+    if (!SDL_IntersectRect(&dirty, &screen, &clip)) continue;
+
+    SDL_SetClipRect(target, &clip);
+    SDL_FillRect(target, &clip, SDL_MapRGB(target->format, 0, 0, 0));
+    for (const Draw& draw : m_draws) {
+      if (!SDL_HasIntersection(&draw.destination, &clip)) continue;
+
+      SDL_Surface* surface{prepare(draw, target->format)};
+      if (!surface) continue;
+
+      SDL_Rect position{draw.destination};
+      SDL_BlitSurface(surface, NULL, target, &position);
+    }
+    updates.push_back(clip);
+  }
+  SDL_SetClipRect(target, NULL);
+
+  if (!updates.empty()) {
+    SDL_UpdateWindowSurfaceRects(m_window, updates.data(),
+                                 static_cast<int>(updates.size()));
+    m_updatedRects += static_cast<int>(updates.size());
+  }
+
+  // scaled copies no draw asked for this frame are dropped
+  m_cache.erase(
+      std::remove_if(m_cache.begin(), m_cache.end(),
+                     [this](const Scaled& scaled) {
+                       return std::none_of(m_draws.begin(), m_draws.end(),
+                                           [&scaled](const Draw& draw) {
+                                             return scaled.serves(draw);
+                                           });
+                     }),
+      m_cache.end());
+
+  m_previous.swap(m_draws);
+  m_draws.clear();
+}
+
+}  // namespace engine
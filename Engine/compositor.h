@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "handles.h"
+
+namespace engine {
+
+enum scaleFilter { scale_nearest, scale_bilinear };
+
+// draws surfaces onto a window surface for the programs without a
+// renderer. stretched surfaces are scaled once and reused while their
+// source and size stay the same, and present() only redraws and pushes
+// the parts of the window whose draws changed since the last frame
+class Compositor {
+ public:
+  explicit Compositor(SDL_Window* window = nullptr);
+
+  void setWindow(SDL_Window* window);
+
+  // queues source stretched over destination, the whole window when null.
+  // the surface has to stay alive until present(). colour keyed surfaces
+  // always scale nearest, keeping their key
+  void draw(SDL_Surface* source, const SDL_Rect* destination = nullptr,
+            scaleFilter filter = scale_nearest);
+
+  // redraws what changed and updates only those window rectangles
+  void present();
+
+  // scaled copies are keyed by the surface pointer: call this when a drawn
+  // surface's pixels change in place, and before freeing it
+  void invalidate(SDL_Surface* source);
+
+  // forgets the previous frame, so the next present() redraws everything
+  void redrawAll();
+
+  // rectangles pushed and scaled copies made since the last resetStats()
+  int getUpdatedRects() const { return m_updatedRects; }
+  int getScales() const { return m_scales; }
+  void resetStats();
+
+ private:
+  struct Draw {
+    SDL_Surface* source;
+    SDL_Rect destination;
+    scaleFilter filter;
+
+    bool operator==(const Draw& other) const {
+      return source == other.source && filter == other.filter &&
+             SDL_RectEquals(&destination, &other.destination);
+    }
+  };
+
+  struct Scaled {
+    SDL_Surface* source;
+    int width;
+    int height;
+    scaleFilter filter;
+    SurfaceHandle surface;
+
+    bool serves(const Draw& draw) const {
+      return source == draw.source && width == draw.destination.w &&
+             height == draw.destination.h && filter == draw.filter;
+    }
+  };
+
+  // the surface to copy for a draw: the source itself when it needs no
+  // scaling, otherwise a cached scaled copy in the window's format
+  SDL_Surface* prepare(const Draw& draw, const SDL_PixelFormat* format);
+
+  SDL_Window* m_window{nullptr};
+  SDL_Surface* m_target{nullptr};
+
+  std::vector<Draw> m_draws;
+  std::vector<Draw> m_previous;
+  std::vector<Scaled> m_cache;
+  std::vector<SDL_Rect> m_dirty;
+
+  int m_updatedRects{};
+  int m_scales{};
+};
+
+}  // namespace engine
@@ -0,0 +1,122 @@
+#include "context.h"
+
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <iostream>
+
+#include "embeddedAssets.h"
+
+namespace engine {
+
+Context::~Context() { close(); }
+
+bool Context::init(const ContextConfig& config) {
+  close();
+
+  Uint32 windowFlags{config.windowFlags};
+  Uint32 rendererFlags{config.rendererFlags};
+  if (config.headless) {
+    // drivers are picked from the environment when SDL_Init runs
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    windowFlags = (windowFlags & ~SDL_WINDOW_SHOWN) | SDL_WINDOW_HIDDEN;
+    rendererFlags = SDL_RENDERER_SOFTWARE;
+  }
+
+  Uint32 sdlFlags{SDL_INIT_VIDEO};
+  if (config.subsystems & subsystem_mixer) sdlFlags |= SDL_INIT_AUDIO;
+
+  if (SDL_Init(sdlFlags) < 0) {
+    std::cerr << "Error initializing sdl: " << SDL_GetError() << '\n';
+    return false;
+  }
+  m_sdlInitialized = true;
+
+  // loose files are used whenever there is no pack, and an embedding
+  // build never looks for one
+  if (!config.assetPack.empty() && embeddedAssetCount == 0 &&
+      m_pack.open(config.assetPack)) {
+    mountPack(&m_pack);
+  }
+
+  if (config.subsystems & subsystem_image) {
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+      std::cerr << "Error initializing img: " << IMG_GetError() << '\n';
+      return false;
+    }
+    m_subsystems |= subsystem_image;
+  }
+
+  if (config.subsystems & subsystem_mixer) {
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+      std::cerr << "Error initializing mixer: " << Mix_GetError() << '\n';
+      return false;
+    }
+    m_subsystems |= subsystem_mixer;
+  }
+
+  if (config.subsystems & subsystem_ttf) {
+    if (TTF_Init() == -1) {
+      std::cerr << "TTF Init Failure: " << TTF_GetError() << '\n';
+      return false;
+    }
+    m_subsystems |= subsystem_ttf;
+  }
+
+  m_window.reset(SDL_CreateWindow(config.title.c_str(), SDL_WINDOWPOS_UNDEFINED,
+                                  SDL_WINDOWPOS_UNDEFINED, config.width,
+                                  config.height, windowFlags));
+
+  if (!m_window) {
+    std::cerr << "SDL Window Creation Failure: " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  m_width = config.width;
+  m_height = config.height;
+
+  if (!config.createRenderer) return true;
+
+  m_renderer.reset(
+      SDL_CreateRenderer(m_window.get(), -1, rendererFlags));
+
+  if (!m_renderer) {
+    std::cerr << "SDL Renderer Creation Failure: " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  if (SDL_SetRenderDrawColor(m_renderer.get(), 0xFF, 0xFF, 0xFF, 0xFF) != 0) {
+    std::cerr << "SDL RENDERER DRAW ERROR: " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  return true;
+}
+
+void Context::close() {
+  // renderer before window, window before the libraries
+  m_renderer.reset();
+  m_window.reset();
+
+  if (m_subsystems & subsystem_ttf) TTF_Quit();
+  if (m_subsystems & subsystem_mixer) Mix_CloseAudio();
+  if (m_subsystems & subsystem_image) IMG_Quit();
+  m_subsystems = subsystem_none;
+
+  if (m_sdlInitialized) {
+    SDL_Quit();
+    m_sdlInitialized = false;
+  }
+
+  m_pack.close();
+}
+
+SDL_Surface* Context::windowSurface() const {
+  if (!m_window) return nullptr;
+  return SDL_GetWindowSurface(m_window.get());
+}
+
+}  // namespace engine
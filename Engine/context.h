@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+
+#include "assetPack.h"
+#include "handles.h"
+
+namespace engine {
+
+// optional libraries brought up alongside SDL video
+enum subsystem : Uint32 {
+  subsystem_none = 0,
+  subsystem_image = 1 << 0,
+  subsystem_ttf = 1 << 1,
+  subsystem_mixer = 1 << 2,
+};
+
+struct ContextConfig {
+  std::string title{"engine"};
+  int width{800};
+  int height{600};
+  Uint32 subsystems{subsystem_none};
+  Uint32 windowFlags{SDL_WINDOW_SHOWN};
+
+  // surface programs draw straight to the window surface instead
+  bool createRenderer{true};
+  Uint32 rendererFlags{SDL_RENDERER_ACCELERATED};
+
+  // dummy video and audio drivers with the software renderer, for running
+  // without a display, sound card or gpu
+  bool headless{false};
+
+  // mounted for every media load when the file exists, relative like the
+  // loose ../img and ../sound paths it replaces; empty to never look.
+  // ignored when the build embeds its assets (EMBED_ASSETS)
+  std::string assetPack{"../assets.pack"};
+};
+
+// owns SDL initialization, the window and its renderer
+class Context {
+ public:
+  Context() = default;
+  ~Context();
+
+  Context(const Context&) = delete;
+  Context& operator=(const Context&) = delete;
+
+  bool init(const ContextConfig& config);
+
+  // destroys the window and shuts down every subsystem init() started
+  void close();
+
+  SDL_Window* window() const { return m_window.get(); }
+  SDL_Renderer* renderer() const { return m_renderer.get(); }
+  SDL_Surface* windowSurface() const;
+
+  int getWidth() const { return m_width; }
+  int getHeight() const { return m_height; }
+
+ private:
+  // declared first so it is unmapped after everything loaded from it
+  AssetPack m_pack;
+  WindowHandle m_window;
+  RendererHandle m_renderer;
+  Uint32 m_subsystems{subsystem_none};
+  bool m_sdlInitialized{false};
+  int m_width{};
+  int m_height{};
+};
+
+}  // namespace engine
@@ -0,0 +1,19 @@
+#include "embeddedAssets.h"
+
+#include <algorithm>
+
+namespace engine {
+
+const EmbeddedAsset* findEmbeddedAsset(AssetId asset) {
+  if (embeddedAssetCount == 0) return nullptr;
+
+  const EmbeddedAsset* end{embeddedAssetTable + embeddedAssetCount};
+  const EmbeddedAsset* found{std::lower_bound(
+      embeddedAssetTable, end, asset.hash(),
+      [](const EmbeddedAsset& entry, Uint64 id) { return entry.id < id; })};
+
+  if (found == end || found->id != asset.hash()) return nullptr;
+  return found;
+}
+
+}  // namespace engine
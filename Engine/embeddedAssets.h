@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+
+#include "assetId.h"
+
+namespace engine {
+
+// one file compiled into the executable
+struct EmbeddedAsset {
+  // hashPath(name), computed by the generator
+  Uint64 id;
+  const char* name;
+  const unsigned char* data;
+  size_t size;
+};
+
+// generated at build time by Tools/assetEmbedder from the EMBEDDED_ASSETS
+// list in CMakeLists.txt (empty unless EMBED_ASSETS is on). sorted by
+// id and ended by an entry with a null name; the generator fails the build
+// when two names share an id
+extern const EmbeddedAsset embeddedAssetTable[];
+extern const size_t embeddedAssetCount;
+
+// the compiled-in copy of an asset, or null
+const EmbeddedAsset* findEmbeddedAsset(AssetId asset);
+
+}  // namespace engine
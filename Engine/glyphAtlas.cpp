@@ -0,0 +1,188 @@
+#include "glyphAtlas.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "handles.h"
+
+namespace engine {
+
+namespace {
+// decodes one UTF-8 sequence and advances text, malformed bytes become '?'
+Uint32 nextCodepoint(const char*& text) {
+  const unsigned char* bytes{reinterpret_cast<const unsigned char*>(text)};
+  Uint32 lead{bytes[0]};
+
+  int length{1};
+  Uint32 codepoint{lead};
+  if (lead >= 0xf0) {
+    length = 4;
+    codepoint = lead & 0x07;
+  } else if (lead >= 0xe0) {
+    length = 3;
+    codepoint = lead & 0x0f;
+  } else if (lead >= 0xc0) {
+    length = 2;
+    codepoint = lead & 0x1f;
+  } else if (lead >= 0x80) {
+    text++;
+    return '?';
+  }
+
+  for (int i{1}; i < length; i++) {
+    if ((bytes[i] & 0xc0) != 0x80) {
+      text += i;
+      return '?';
+    }
+    codepoint = (codepoint << 6) | (bytes[i] & 0x3f);
+  }
+
+  text += length;
+  return codepoint;
+}
+}  // namespace
+
+constexpr Uint32 GlyphAtlas::asciiCount;
+
+GlyphAtlas::GlyphAtlas() : m_packer{1, 1} {}
+
+bool GlyphAtlas::load(SDL_Renderer* renderer, TTF_Font* font, int pageSize) {
+  m_font = font;
+  m_extended.clear();
+  for (Glyph& glyph : m_ascii) glyph = Glyph{};
+
+  if (!m_texture.create(renderer, pageSize, pageSize,
+                        SDL_TEXTUREACCESS_STATIC)) {
+    return false;
+  }
+  m_texture.setBlendMode(SDL_BLENDMODE_BLEND);
+
+  // texture memory starts undefined, clear it once
+  std::vector<Uint32> blank(static_cast<size_t>(pageSize) * pageSize, 0);
+  SDL_UpdateTexture(m_texture.get(), NULL, blank.data(),
+                    pageSize * static_cast<int>(sizeof(Uint32)));
+
+  m_packer = AtlasPacker{pageSize, pageSize};
+  m_kerning = TTF_GetFontKerning(font) != 0;
+  m_lineHeight = TTF_FontHeight(font);
+
+  for (Uint32 codepoint{' '}; codepoint < asciiCount - 1; codepoint++) {
+    rasterize(codepoint, m_ascii[codepoint]);
+  }
+
+  return true;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::glyph(Uint32 codepoint) {
+  Glyph& glyph{codepoint < asciiCount ? m_ascii[codepoint]
+                                      : m_extended[codepoint]};
+  if (!glyph.loaded) rasterize(codepoint, glyph);
+  return glyph;
+}
+
+void GlyphAtlas::rasterize(Uint32 codepoint, Glyph& glyph) {
+  glyph.loaded = true;
+  if (!m_font) return;
+
+  int minX{}, maxX{}, minY{}, maxY{};
+  if (TTF_GlyphMetrics32(m_font, codepoint, &minX, &maxX, &minY, &maxY,
+                         &glyph.advance) != 0) {
+    return;
+  }
+
+  // white so the draw colour can tint it through the vertices
+  SurfaceHandle rendered{TTF_RenderGlyph32_Blended(
+      m_font, codepoint, SDL_Color{0xff, 0xff, 0xff, 0xff})};
+  if (!rendered) return;
+
+  SurfaceHandle pixels{
+      SDL_ConvertSurfaceFormat(rendered.get(), SDL_PIXELFORMAT_ARGB8888, 0)};
+  if (!pixels) return;
+
+  SDL_Point position{};
+  if (!m_packer.insert(pixels->w, pixels->h, position)) {
+    std::cerr << "Glyph atlas full, dropping U+" << std::hex << codepoint
+              << std::dec << '\n';
+    return;
+  }
+
+  glyph.rect = SDL_Rect{position.x, position.y, pixels->w, pixels->h};
+  glyph.offsetX = std::min(0, minX);
+  SDL_UpdateTexture(m_texture.get(), &glyph.rect, pixels->pixels,
+                    pixels->pitch);
+}
+
+int GlyphAtlas::measure(const char* text) {
+  int width{0};
+  Uint32 previous{0};
+
+  while (*text) {
+    Uint32 codepoint{nextCodepoint(text)};
+    if (m_kerning && previous) {
+      width += TTF_GetFontKerningSizeGlyphs32(m_font, previous, codepoint);
+    }
+    width += glyph(codepoint).advance;
+    previous = codepoint;
+  }
+
+  return width;
+}
+
+template <typename Emit>
+void GlyphAtlas::layout(const char* text, int x, int y, double angle,
+                        Emit emit) {
+  if (!m_texture) return;
+
+  // rotating needs the whole string's centre, so only then measure first
+  float centreX{angle != 0.0 ? measure(text) * 0.5f : 0.0f};
+  float centreY{m_lineHeight * 0.5f};
+
+  int pen{0};
+  Uint32 previous{0};
+
+  while (*text) {
+    Uint32 codepoint{nextCodepoint(text)};
+    if (m_kerning && previous) {
+      pen += TTF_GetFontKerningSizeGlyphs32(m_font, previous, codepoint);
+    }
+
+    const Glyph& current{glyph(codepoint)};
+    if (current.rect.w > 0) {
+      float left{static_cast<float>(pen + current.offsetX)};
+      SDL_FRect destination{x + left, static_cast<float>(y),
+                            static_cast<float>(current.rect.w),
+                            static_cast<float>(current.rect.h)};
+      SDL_FPoint centre{centreX - left, centreY};
+
+      emit(destination, current.rect, angle != 0.0 ? &centre : nullptr);
+    }
+
+    pen += current.advance;
+    previous = codepoint;
+  }
+}
+
+void GlyphAtlas::draw(SpriteBatch& batch, const char* text, int x, int y,
+                      SDL_Color color, double angle) {
+  SDL_Texture* texture{m_texture.get()};
+  layout(text, x, y, angle,
+         [&](const SDL_FRect& destination, const SDL_Rect& clip,
+             const SDL_FPoint* centre) {
+           batch.draw(texture, destination, &clip, angle, centre,
+                      SDL_FLIP_NONE, color);
+         });
+}
+
+void GlyphAtlas::draw(RenderQueue& queue, Uint8 layer, const char* text,
+                      int x, int y, SDL_Color color, double angle) {
+  SDL_Texture* texture{m_texture.get()};
+  layout(text, x, y, angle,
+         [&](const SDL_FRect& destination, const SDL_Rect& clip,
+             const SDL_FPoint* centre) {
+           queue.submit(layer, texture, destination, &clip, color,
+                        SDL_BLENDMODE_BLEND, angle, centre);
+         });
+}
+
+}  // namespace engine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "atlas.h"
+#include "renderQueue.h"
+#include "spriteBatch.h"
+#include "texture.h"
+
+namespace engine {
+
+// rasterizes each glyph of a font once into a single texture and draws
+// strings as batched quads, so changing text never touches the GPU
+class GlyphAtlas {
+ public:
+  GlyphAtlas();
+
+  // printable ASCII is rasterized here, anything else on first use
+  bool load(SDL_Renderer* renderer, TTF_Font* font, int pageSize = 512);
+
+  // draws UTF-8 text with its top left at (x, y), rotated about its centre
+  void draw(SpriteBatch& batch, const char* text, int x, int y,
+            SDL_Color color, double angle = 0.0);
+  void draw(SpriteBatch& batch, const std::string& text, int x, int y,
+            SDL_Color color, double angle = 0.0) {
+    draw(batch, text.c_str(), x, y, color, angle);
+  }
+
+  // same, recorded into a render queue on the given layer
+  void draw(RenderQueue& queue, Uint8 layer, const char* text, int x, int y,
+            SDL_Color color, double angle = 0.0);
+  void draw(RenderQueue& queue, Uint8 layer, const std::string& text, int x,
+            int y, SDL_Color color, double angle = 0.0) {
+    draw(queue, layer, text.c_str(), x, y, color, angle);
+  }
+
+  // width in pixels including kerning
+  int measure(const char* text);
+
+  int getLineHeight() const { return m_lineHeight; }
+  const Texture& getTexture() const { return m_texture; }
+
+ private:
+  struct Glyph {
+    SDL_Rect rect{};
+    int offsetX{};
+    int advance{};
+    bool loaded{false};
+  };
+
+  const Glyph& glyph(Uint32 codepoint);
+  void rasterize(Uint32 codepoint, Glyph& glyph);
+
+  // places each glyph of the string and hands its quad to emit
+  template <typename Emit>
+  void layout(const char* text, int x, int y, double angle, Emit emit);
+
+  TTF_Font* m_font{nullptr};
+  Texture m_texture;
+  AtlasPacker m_packer;
+  bool m_kerning{false};
+  int m_lineHeight{};
+
+  static constexpr Uint32 asciiCount{128};
+  Glyph m_ascii[asciiCount];
+  std::unordered_map<Uint32, Glyph> m_extended;
+};
+
+}  // namespace engine
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <memory>
+
+namespace engine {
+
+// deleters so the raw SDL pointers can live in std::unique_ptr
+struct WindowDeleter {
+  void operator()(SDL_Window* window) const { SDL_DestroyWindow(window); }
+};
+
+struct RendererDeleter {
+  void operator()(SDL_Renderer* renderer) const {
+    SDL_DestroyRenderer(renderer);
+  }
+};
+
+struct TextureDeleter {
+  void operator()(SDL_Texture* texture) const { SDL_DestroyTexture(texture); }
+};
+
+struct SurfaceDeleter {
+  void operator()(SDL_Surface* surface) const { SDL_FreeSurface(surface); }
+};
+
+struct FontDeleter {
+  void operator()(TTF_Font* font) const { TTF_CloseFont(font); }
+};
+
+struct ChunkDeleter {
+  void operator()(Mix_Chunk* chunk) const { Mix_FreeChunk(chunk); }
+};
+
+struct MusicDeleter {
+  void operator()(Mix_Music* music) const { Mix_FreeMusic(music); }
+};
+
+// owning handles, destroyed exactly once when they go out of scope
+using WindowHandle = std::unique_ptr<SDL_Window, WindowDeleter>;
+using RendererHandle = std::unique_ptr<SDL_Renderer, RendererDeleter>;
+using TextureHandle = std::unique_ptr<SDL_Texture, TextureDeleter>;
+using SurfaceHandle = std::unique_ptr<SDL_Surface, SurfaceDeleter>;
+using FontHandle = std::unique_ptr<TTF_Font, FontDeleter>;
+using ChunkHandle = std::unique_ptr<Mix_Chunk, ChunkDeleter>;
+using MusicHandle = std::unique_ptr<Mix_Music, MusicDeleter>;
+
+}  // namespace engine
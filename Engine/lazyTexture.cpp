@@ -0,0 +1,104 @@
+#include "lazyTexture.h"
+
+#include <utility>
+
+#include "handles.h"
+
+namespace engine {
+
+namespace {
+const Texture empty;
+}  // namespace
+
+LazyTexture::LazyTexture(std::shared_ptr<State> state)
+    : m_state{std::move(state)} {}
+
+bool LazyTexture::isReady() const {
+  return m_state && m_state->status.load(std::memory_order_acquire) ==
+                        load_ready;
+}
+
+bool LazyTexture::hasFailed() const {
+  return m_state && m_state->status.load(std::memory_order_acquire) ==
+                        load_failed;
+}
+
+const Texture& LazyTexture::get() const {
+  return isReady() ? m_state->texture : empty;
+}
+
+int LazyTexture::getWidth() const {
+  if (!m_state) return 0;
+  return isReady() ? m_state->texture.getWidth() : m_state->width;
+}
+
+int LazyTexture::getHeight() const {
+  if (!m_state) return 0;
+  return isReady() ? m_state->texture.getHeight() : m_state->height;
+}
+
+const Texture* LazyTexture::current(const SDL_Rect* clip,
+                                    SDL_Rect& size) const {
+  if (!m_state) return nullptr;
+
+  if (isReady()) {
+    const Texture& texture{m_state->texture};
+    size.w = clip ? clip->w : texture.getWidth();
+    size.h = clip ? clip->h : texture.getHeight();
+    return &texture;
+  }
+
+  size.w = clip ? clip->w : m_state->width;
+  size.h = clip ? clip->h : m_state->height;
+  if (!m_state->placeholder || size.w <= 0 || size.h <= 0) return nullptr;
+  return m_state->placeholder.get();
+}
+
+void LazyTexture::render(int x, int y, const SDL_Rect* clip, double angle,
+                         const SDL_Point* centre,
+                         SDL_RendererFlip flip) const {
+  SDL_Rect destination{x, y, 0, 0};
+  const Texture* texture{current(clip, destination)};
+  if (!texture) return;
+
+  // the placeholder is drawn whole, whatever part of the image was asked for
+  if (!isReady()) clip = nullptr;
+  SDL_RenderCopyEx(texture->getRenderer(), texture->get(), clip,
+                   &destination, angle, centre, flip);
+}
+
+void LazyTexture::render(RenderQueue& queue, Uint8 layer, int x, int y,
+                         const SDL_Rect* clip, SDL_Color tint,
+                         SDL_BlendMode blending) const {
+  SDL_Rect destination{x, y, 0, 0};
+  const Texture* texture{current(clip, destination)};
+  if (!texture) return;
+
+  if (isReady()) {
+    queue.submit(layer, *texture, x, y, clip, tint, blending);
+  } else {
+    queue.submit(layer, *texture, destination, nullptr, tint, blending);
+  }
+}
+
+Texture makePlaceholder(SDL_Renderer* renderer) {
+  constexpr int size{8};
+  SurfaceHandle checker{SDL_CreateRGBSurfaceWithFormat(
+      0, size, size, 32, SDL_PIXELFORMAT_ARGB8888)};
+
+  Texture placeholder;
+  if (!checker) return placeholder;
+
+  Uint8* pixels{static_cast<Uint8*>(checker->pixels)};
+  for (int y{0}; y < size; y++) {
+    Uint32* row{reinterpret_cast<Uint32*>(pixels + y * checker->pitch)};
+    for (int x{0}; x < size; x++) {
+      row[x] = ((x / 2 + y / 2) % 2) ? 0xff808080 : 0xffc0c0c0;
+    }
+  }
+
+  placeholder.loadSurface(renderer, checker.get());
+  return placeholder;
+}
+
+}  // namespace engine
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <memory>
+
+#include "renderQueue.h"
+#include "texture.h"
+
+namespace engine {
+
+// a texture that can be drawn before its image has loaded. until
+// AssetLoader::update() swaps the real texture in it draws a placeholder
+// stretched to the clip (or the size it was requested with), or nothing
+// when neither is known; a failed load keeps the placeholder. copies
+// share one texture. made by AssetLoader::requestTexture()
+class LazyTexture {
+ public:
+  LazyTexture() = default;
+
+  // like Texture::render
+  void render(int x, int y, const SDL_Rect* clip = nullptr, double angle = 0.0,
+              const SDL_Point* centre = nullptr,
+              SDL_RendererFlip flip = SDL_FLIP_NONE) const;
+
+  // like RenderQueue::submit
+  void render(RenderQueue& queue, Uint8 layer, int x, int y,
+              const SDL_Rect* clip = nullptr,
+              SDL_Color tint = SDL_Color{0xff, 0xff, 0xff, 0xff},
+              SDL_BlendMode blending = SDL_BLENDMODE_BLEND) const;
+
+  // the loaded texture, or an empty one (which draws nothing) before then
+  const Texture& get() const;
+
+  bool isReady() const;
+  bool hasFailed() const;
+
+  // the loaded size, or the requested one while loading
+  int getWidth() const;
+  int getHeight() const;
+
+ private:
+  friend class AssetLoader;
+
+  enum loadState { load_pending, load_ready, load_failed };
+
+  struct State {
+    // written last by the loader, so a texture is only ever seen whole
+    std::atomic<int> status{load_pending};
+    Texture texture;
+    std::shared_ptr<const Texture> placeholder;
+    int width{0};
+    int height{0};
+  };
+
+  explicit LazyTexture(std::shared_ptr<State> state);
+
+  // what to draw now and at which size, null when nothing
+  const Texture* current(const SDL_Rect* clip, SDL_Rect& size) const;
+
+  std::shared_ptr<State> m_state;
+};
+
+// an 8x8 grey checkerboard, small enough to make per renderer up front
+Texture makePlaceholder(SDL_Renderer* renderer);
+
+}  // namespace engine
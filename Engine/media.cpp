@@ -0,0 +1,150 @@
+#include "media.h"
+
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <iostream>
+
+#include "assetPack.h"
+#include "pixelOps.h"
+
+namespace engine {
+
+namespace {
+// a pack entry or the file itself; a missing file is reported here since
+// the loaders would only complain about a null stream
+SDL_RWops* openSource(AssetId asset) {
+  SDL_RWops* source{openAsset(asset)};
+  if (!source) {
+    std::cerr << "Error loading " << asset.path() << ": " << SDL_GetError()
+              << '\n';
+  }
+  return source;
+}
+}  // namespace
+
+SurfaceHandle applyColorKey(SurfaceHandle surface) {
+  if (!surface) return nullptr;
+
+  if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+    surface.reset(SDL_ConvertSurfaceFormat(surface.get(),
+                                           SDL_PIXELFORMAT_ARGB8888, 0));
+    if (!surface) {
+      std::cerr << "Error converting surface: " << SDL_GetError() << '\n';
+      return nullptr;
+    }
+  }
+
+  const Uint32 key{static_cast<Uint32>(colorKeyRed) << 16 |
+                   static_cast<Uint32>(colorKeyGreen) << 8 | colorKeyBlue};
+
+  SDL_LockSurface(surface.get());
+  Uint8* row{static_cast<Uint8*>(surface->pixels)};
+  for (int y{0}; y < surface->h; y++, row += surface->pitch) {
+    keyToAlpha(reinterpret_cast<Uint32*>(row), surface->w, key);
+  }
+  SDL_UnlockSurface(surface.get());
+
+  return surface;
+}
+
+SurfaceHandle loadImage(AssetId asset) {
+  SDL_RWops* source{openSource(asset)};
+  if (!source) return nullptr;
+
+  SurfaceHandle surface{IMG_Load_RW(source, 1)};
+
+  if (!surface) {
+    std::cerr << "Error loading " << asset.path() << ": " << IMG_GetError()
+              << '\n';
+  }
+
+  return surface;
+}
+
+SurfaceHandle loadBMP(AssetId asset) {
+  SDL_RWops* source{openSource(asset)};
+  if (!source) return nullptr;
+
+  SurfaceHandle surface{SDL_LoadBMP_RW(source, 1)};
+
+  if (!surface) {
+    std::cerr << "Error loading " << asset.path() << ": " << SDL_GetError()
+              << '\n';
+  }
+
+  return surface;
+}
+
+SurfaceHandle convertSurface(SDL_Surface* surface,
+                             const SDL_PixelFormat* format) {
+  if (!surface) return nullptr;
+
+  SurfaceHandle converted{SDL_ConvertSurface(surface, format, 0)};
+
+  if (!converted) {
+    std::cerr << "Error converting surface: " << SDL_GetError() << '\n';
+  }
+
+  return converted;
+}
+
+FontHandle loadFont(AssetId asset, int pointSize) {
+  SDL_RWops* source{openSource(asset)};
+  if (!source) return nullptr;
+
+  // the font keeps reading glyphs from the stream and frees it on close
+  FontHandle font{TTF_OpenFontRW(source, 1, pointSize)};
+
+  if (!font) {
+    std::cerr << "Error opening font: " << TTF_GetError() << '\n';
+  }
+
+  return font;
+}
+
+SurfaceHandle renderText(TTF_Font* font, const std::string& text,
+                         SDL_Color color, const SDL_Color* background) {
+  SurfaceHandle surface{
+      background
+          ? TTF_RenderUTF8_Shaded(font, text.c_str(), color, *background)
+          : TTF_RenderUTF8_Solid(font, text.c_str(), color)};
+
+  if (!surface) {
+    std::cerr << "Error creating text: " << TTF_GetError() << '\n';
+  }
+
+  return surface;
+}
+
+ChunkHandle loadChunk(AssetId asset) {
+  SDL_RWops* source{openSource(asset)};
+  if (!source) return nullptr;
+
+  ChunkHandle chunk{Mix_LoadWAV_RW(source, 1)};
+
+  if (!chunk) {
+    std::cerr << "Failed to load " << asset.path() << "\n"
+              << Mix_GetError() << '\n';
+  }
+
+  return chunk;
+}
+
+MusicHandle loadMusic(AssetId asset) {
+  SDL_RWops* source{openSource(asset)};
+  if (!source) return nullptr;
+
+  // music streams from the source for as long as it plays
+  MusicHandle music{Mix_LoadMUS_RW(source, 1)};
+
+  if (!music) {
+    std::cerr << "Failed to load " << asset.path() << "\n"
+              << Mix_GetError() << '\n';
+  }
+
+  return music;
+}
+
+}  // namespace engine
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+
+#include "assetId.h"
+#include "handles.h"
+
+namespace engine {
+
+// the cyan every sprite sheet in ../img uses as its transparent colour
+constexpr Uint8 colorKeyRed{0x00};
+constexpr Uint8 colorKeyGreen{0xff};
+constexpr Uint8 colorKeyBlue{0xff};
+
+// the font every text program uses, kept in fonts/ beside img/ and sound/
+// (or compiled in, see EMBED_ASSETS)
+constexpr char defaultFontPath[]{"../fonts/mononoki-Regular.ttf"};
+
+// the surface as ARGB8888 with its cyan background turned into real
+// alpha, so textures made from it are plain alpha blended. converts in
+// place when the surface already is ARGB8888; null stays null
+SurfaceHandle applyColorKey(SurfaceHandle surface);
+
+// decodes any format SDL_image knows, errors are reported to std::cerr
+SurfaceHandle loadImage(AssetId asset);
+
+// plain bitmap loading for the programs that never start SDL_image
+SurfaceHandle loadBMP(AssetId asset);
+
+// converts to the given format (usually the window surface's)
+SurfaceHandle convertSurface(SDL_Surface* surface,
+                             const SDL_PixelFormat* format);
+
+FontHandle loadFont(AssetId asset, int pointSize);
+
+// solid text, or shaded text when a background is given
+SurfaceHandle renderText(TTF_Font* font, const std::string& text,
+                         SDL_Color color,
+                         const SDL_Color* background = nullptr);
+
+ChunkHandle loadChunk(AssetId asset);
+MusicHandle loadMusic(AssetId asset);
+
+}  // namespace engine
@@ -0,0 +1,209 @@
+#include "mixOps.h"
+
+#include <algorithm>
+
+#include "simd.h"
+
+namespace engine {
+
+namespace {
+constexpr float sampleMin{-32768.0f};
+constexpr float sampleMax{32767.0f};
+
+void mixVoiceScalar(float* mix, const Sint16* source, size_t frames,
+                    float left, float right) {
+  for (size_t i{0}; i < frames; i++) {
+    mix[i * 2] += source[i * 2] * left;
+    mix[i * 2 + 1] += source[i * 2 + 1] * right;
+  }
+}
+
+void saturateS16Scalar(Sint16* output, const float* mix, size_t samples,
+                       float gain) {
+  for (size_t i{0}; i < samples; i++) {
+    float sample{output[i] + mix[i] * gain};
+    sample = std::min(std::max(sample, sampleMin), sampleMax);
+    output[i] = static_cast<Sint16>(sample);
+  }
+}
+
+#ifdef ENGINE_SSE2
+// four stereo frames a step: the samples are sign extended to 32 bits by
+// pairing each with itself and shifting the copy back out
+void mixVoiceSSE2(float* mix, const Sint16* source, size_t frames, float left,
+                  float right) {
+  const __m128 gains{_mm_setr_ps(left, right, left, right)};
+
+  size_t i{0};
+  for (; i + 4 <= frames; i += 4) {
+    __m128i packed{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2))};
+    __m128i low{_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16)};
+    __m128i high{_mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16)};
+
+    float* at{mix + i * 2};
+    _mm_storeu_ps(at, _mm_add_ps(_mm_loadu_ps(at),
+                                 _mm_mul_ps(_mm_cvtepi32_ps(low), gains)));
+    _mm_storeu_ps(at + 4,
+                  _mm_add_ps(_mm_loadu_ps(at + 4),
+                             _mm_mul_ps(_mm_cvtepi32_ps(high), gains)));
+  }
+  mixVoiceScalar(mix + i * 2, source + i * 2, frames - i, left, right);
+}
+
+void saturateS16SSE2(Sint16* output, const float* mix, size_t samples,
+                     float gain) {
+  const __m128 scale{_mm_set1_ps(gain)};
+  const __m128 lowest{_mm_set1_ps(sampleMin)};
+  const __m128 highest{_mm_set1_ps(sampleMax)};
+
+  size_t i{0};
+  for (; i + 8 <= samples; i += 8) {
+    __m128i* at{reinterpret_cast<__m128i*>(output + i)};
+    __m128i packed{_mm_loadu_si128(at)};
+    __m128 low{_mm_cvtepi32_ps(
+        _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16))};
+    __m128 high{_mm_cvtepi32_ps(
+        _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16))};
+
+    low = _mm_add_ps(low, _mm_mul_ps(_mm_loadu_ps(mix + i), scale));
+    high = _mm_add_ps(high, _mm_mul_ps(_mm_loadu_ps(mix + i + 4), scale));
+    low = _mm_min_ps(_mm_max_ps(low, lowest), highest);
+    high = _mm_min_ps(_mm_max_ps(high, lowest), highest);
+    _mm_storeu_si128(at, _mm_packs_epi32(_mm_cvttps_epi32(low),
+                                         _mm_cvttps_epi32(high)));
+  }
+  saturateS16Scalar(output + i, mix + i, samples - i, gain);
+}
+#endif
+
+#ifdef ENGINE_AVX2
+ENGINE_TARGET_AVX2
+void mixVoiceAVX2(float* mix, const Sint16* source, size_t frames, float left,
+                  float right) {
+  const __m256 gains{
+      _mm256_setr_ps(left, right, left, right, left, right, left, right)};
+
+  size_t i{0};
+  for (; i + 8 <= frames; i += 8) {
+    const __m128i* from{reinterpret_cast<const __m128i*>(source + i * 2)};
+    __m256i low{_mm256_cvtepi16_epi32(_mm_loadu_si128(from))};
+    __m256i high{_mm256_cvtepi16_epi32(_mm_loadu_si128(from + 1))};
+
+    float* at{mix + i * 2};
+    _mm256_storeu_ps(
+        at, _mm256_add_ps(_mm256_loadu_ps(at),
+                          _mm256_mul_ps(_mm256_cvtepi32_ps(low), gains)));
+    _mm256_storeu_ps(
+        at + 8, _mm256_add_ps(_mm256_loadu_ps(at + 8),
+                              _mm256_mul_ps(_mm256_cvtepi32_ps(high), gains)));
+  }
+  mixVoiceScalar(mix + i * 2, source + i * 2, frames - i, left, right);
+}
+
+ENGINE_TARGET_AVX2
+void saturateS16AVX2(Sint16* output, const float* mix, size_t samples,
+                     float gain) {
+  const __m256 scale{_mm256_set1_ps(gain)};
+  const __m256 lowest{_mm256_set1_ps(sampleMin)};
+  const __m256 highest{_mm256_set1_ps(sampleMax)};
+
+  size_t i{0};
+  for (; i + 16 <= samples; i += 16) {
+    __m128i* at{reinterpret_cast<__m128i*>(output + i)};
+    __m256 low{_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(at)))};
+    __m256 high{
+        _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(at + 1)))};
+
+    low = _mm256_add_ps(low, _mm256_mul_ps(_mm256_loadu_ps(mix + i), scale));
+    high = _mm256_add_ps(high,
+                         _mm256_mul_ps(_mm256_loadu_ps(mix + i + 8), scale));
+    low = _mm256_min_ps(_mm256_max_ps(low, lowest), highest);
+    high = _mm256_min_ps(_mm256_max_ps(high, lowest), highest);
+
+    // packing works within 128 bit lanes, the permute puts them in order
+    __m256i packed{_mm256_packs_epi32(_mm256_cvttps_epi32(low),
+                                      _mm256_cvttps_epi32(high))};
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(at),
+                        _mm256_permute4x64_epi64(packed, 0xd8));
+  }
+  saturateS16Scalar(output + i, mix + i, samples - i, gain);
+}
+#endif
+
+enum simdPath { simd_scalar, simd_sse2, simd_avx2 };
+
+simdPath detectPath() {
+#ifdef ENGINE_AVX2
+  if (SDL_HasAVX2()) return simd_avx2;
+#endif
+#ifdef ENGINE_SSE2
+  if (SDL_HasSSE2()) return simd_sse2;
+#endif
+  return simd_scalar;
+}
+
+simdPath path() {
+  static const simdPath detected{detectPath()};
+  return detected;
+}
+}  // namespace
+
+void mixVoice(float* mix, const Sint16* source, size_t frames, float left,
+              float right) {
+  switch (path()) {
+#ifdef ENGINE_AVX2
+    case simd_avx2:
+      mixVoiceAVX2(mix, source, frames, left, right);
+      return;
+#endif
+#ifdef ENGINE_SSE2
+    case simd_sse2:
+      mixVoiceSSE2(mix, source, frames, left, right);
+      return;
+#endif
+    default:
+      mixVoiceScalar(mix, source, frames, left, right);
+  }
+}
+
+void saturateS16(Sint16* output, const float* mix, size_t samples,
+                 float gain) {
+  switch (path()) {
+#ifdef ENGINE_AVX2
+    case simd_avx2:
+      saturateS16AVX2(output, mix, samples, gain);
+      return;
+#endif
+#ifdef ENGINE_SSE2
+    case simd_sse2:
+      saturateS16SSE2(output, mix, samples, gain);
+      return;
+#endif
+    default:
+      saturateS16Scalar(output, mix, samples, gain);
+  }
+}
+
+void mixVoiceReference(float* mix, const Sint16* source, size_t frames,
+                       float left, float right) {
+  mixVoiceScalar(mix, source, frames, left, right);
+}
+
+void saturateS16Reference(Sint16* output, const float* mix, size_t samples,
+                          float gain) {
+  saturateS16Scalar(output, mix, samples, gain);
+}
+
+const char* mixOpsPath() {
+  switch (path()) {
+    case simd_avx2:
+      return "avx2";
+    case simd_sse2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace engine
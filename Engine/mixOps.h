@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+
+namespace engine {
+
+// the audio mixer's inner loops over interleaved 16 bit stereo, each with
+// a scalar version and SSE2/AVX2 versions chosen once at run time like
+// pixelOps. every path does the same float operations in the same order,
+// so they produce identical samples
+
+// adds frames of source into the float mix, the left channel scaled by
+// left and the right by right (volume and pan already folded in)
+void mixVoice(float* mix, const Sint16* source, size_t frames, float left,
+              float right);
+
+// adds the mix scaled by gain onto output, clamping to 16 bits
+void saturateS16(Sint16* output, const float* mix, size_t samples,
+                 float gain);
+
+// the scalar versions whatever the CPU, to check and time the others by
+void mixVoiceReference(float* mix, const Sint16* source, size_t frames,
+                       float left, float right);
+void saturateS16Reference(Sint16* output, const float* mix, size_t samples,
+                          float gain);
+
+// the path the kernels run on: "avx2", "sse2" or "scalar"
+const char* mixOpsPath();
+
+}  // namespace engine
@@ -0,0 +1,341 @@
+#include "musicStream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "assetPack.h"
+
+namespace engine {
+
+namespace {
+// source frames read from the file per decoder step
+constexpr int stepFrames{4096};
+
+Uint16 readU16(const Uint8* bytes) {
+  Uint16 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE16(value);
+}
+
+Uint32 readU32(const Uint8* bytes) {
+  Uint32 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE32(value);
+}
+}  // namespace
+
+MusicStream::~MusicStream() { close(); }
+
+bool MusicStream::open(AssetId asset, int frequency, double lookahead,
+                       bool loop) {
+  close();
+  m_name = asset.path();
+  m_loop = loop;
+
+  m_source = openAsset(asset);
+  if (!m_source) {
+    std::cerr << "Error loading " << m_name << ": " << SDL_GetError() << '\n';
+    return false;
+  }
+  if (!readHeader()) {
+    close();
+    return false;
+  }
+
+  m_converter = SDL_NewAudioStream(m_format, static_cast<Uint8>(m_channels),
+                                   m_rate, AUDIO_S16SYS, 2, frequency);
+  if (!m_converter) {
+    std::cerr << "Error converting " << m_name << ": " << SDL_GetError()
+              << '\n';
+    close();
+    return false;
+  }
+
+  // a power of two so positions wrap with a mask
+  size_t wanted{static_cast<size_t>(std::max(lookahead, 0.0) * frequency)};
+  m_capacity = 1024;
+  while (m_capacity < wanted) m_capacity *= 2;
+  m_ring.assign(m_capacity * 2, 0);
+  m_input.resize(static_cast<size_t>(stepFrames) * m_frameBytes);
+  m_decoded.resize(static_cast<size_t>(stepFrames) * 2);
+  m_idleMilliseconds = std::max(static_cast<int>(lookahead * 1000 / 8), 1);
+
+  // filled here, before the decoder thread takes over
+  restart();
+  while (decode()) {
+  }
+
+  m_thread = std::thread{&MusicStream::work, this};
+  return true;
+}
+
+void MusicStream::close() {
+  if (m_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+  }
+  m_stopping = false;
+  m_rewind = false;
+
+  if (m_converter) SDL_FreeAudioStream(m_converter);
+  m_converter = nullptr;
+  if (m_source) SDL_RWclose(m_source);
+  m_source = nullptr;
+
+  m_ring.clear();
+  m_capacity = 0;
+  m_written.store(0);
+  m_read.store(0);
+  m_discardUntil.store(0);
+  m_attached.store(false);
+  m_ended.store(false);
+  m_underruns.store(0);
+  m_reported = 0;
+}
+
+void MusicStream::rewind() {
+  if (!m_thread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_rewind = true;
+  }
+  m_wake.notify_one();
+}
+
+void MusicStream::update() {
+  int underruns{m_underruns.load()};
+  if (underruns == m_reported) return;
+
+  std::cerr << "Music underrun in " << m_name << ": "
+            << underruns - m_reported << " buffers short (" << underruns
+            << " so far)\n";
+  m_reported = underruns;
+}
+
+int MusicStream::read(Sint16* output, int frames) {
+  if (m_capacity == 0) return 0;
+
+  // while attached only this side moves past frames a rewind dropped, so
+  // the decoder never refills slots that may still be being copied here
+  size_t position{m_read.load(std::memory_order_relaxed)};
+  const size_t discard{m_discardUntil.load()};
+  const bool skipped{position < discard};
+  if (skipped) position = discard;
+  const size_t written{m_written.load(std::memory_order_acquire)};
+  const size_t count{std::min<size_t>(frames, written - position)};
+
+  // in at most two pieces, either side of the ring's end
+  const size_t start{position & (m_capacity - 1)};
+  const size_t first{std::min(count, m_capacity - start)};
+  std::memcpy(output, m_ring.data() + start * 2, first * 2 * sizeof(Sint16));
+  std::memcpy(output + first * 2, m_ring.data(),
+              (count - first) * 2 * sizeof(Sint16));
+  m_read.store(position + count, std::memory_order_release);
+  // the decoder sleeps on a ring full of dropped frames until now
+  if (skipped) m_wake.notify_one();
+
+  // the buffer a rewind empties is the rewind's gap, not an underrun
+  if (count < static_cast<size_t>(frames) && !skipped &&
+      !m_ended.load(std::memory_order_acquire)) {
+    m_underruns++;
+  }
+  return static_cast<int>(count);
+}
+
+bool MusicStream::isFinished() const {
+  return m_ended.load(std::memory_order_acquire) &&
+         m_read.load(std::memory_order_relaxed) ==
+             m_written.load(std::memory_order_acquire);
+}
+
+void MusicStream::attach() { m_attached.store(true); }
+
+void MusicStream::detach() {
+  m_attached.store(false);
+  // a rewind made while this voice was still attached
+  if (skipDropped()) m_wake.notify_one();
+}
+
+int MusicStream::getBufferedFrames() const {
+  size_t position{std::max(m_read.load(), m_discardUntil.load())};
+  return static_cast<int>(m_written.load() - position);
+}
+
+bool MusicStream::readHeader() {
+  Uint8 riff[12];
+  if (SDL_RWread(m_source, riff, sizeof(riff), 1) != 1 ||
+      std::memcmp(riff, "RIFF", 4) != 0 ||
+      std::memcmp(riff + 8, "WAVE", 4) != 0) {
+    std::cerr << "Error reading " << m_name << ": not a WAV file\n";
+    return false;
+  }
+
+  const Sint64 fileSize{SDL_RWsize(m_source)};
+  bool haveFormat{false};
+  Uint8 chunk[8];
+  while (SDL_RWread(m_source, chunk, sizeof(chunk), 1) == 1) {
+    const Uint32 size{readU32(chunk + 4)};
+    const Sint64 start{SDL_RWtell(m_source)};
+
+    if (std::memcmp(chunk, "fmt ", 4) == 0) {
+      Uint8 format[40]{};
+      if (size < 16 ||
+          SDL_RWread(m_source, format, std::min<Uint32>(size, 40), 1) != 1) {
+        break;
+      }
+      Uint16 tag{readU16(format)};
+      // WAVE_FORMAT_EXTENSIBLE keeps the real tag in its sub format
+      if (tag == 0xfffe && size >= 26) tag = readU16(format + 24);
+      m_channels = readU16(format + 2);
+      m_rate = static_cast<int>(readU32(format + 4));
+      const Uint16 bits{readU16(format + 14)};
+
+      if (tag == 1 && bits == 8) {
+        m_format = AUDIO_U8;
+      } else if (tag == 1 && bits == 16) {
+        m_format = AUDIO_S16LSB;
+      } else if (tag == 1 && bits == 32) {
+        m_format = AUDIO_S32LSB;
+      } else if (tag == 3 && bits == 32) {
+        m_format = AUDIO_F32LSB;
+      } else {
+        std::cerr << "Error reading " << m_name << ": unsupported format "
+                  << tag << " at " << bits << " bits\n";
+        return false;
+      }
+      if (m_channels < 1 || m_channels > 8 || m_rate <= 0) break;
+      m_frameBytes = m_channels * bits / 8;
+      haveFormat = true;
+    } else if (std::memcmp(chunk, "data", 4) == 0 && haveFormat) {
+      // streamed recordings may leave the size unset, so trust the file
+      Uint64 size64{size};
+      if (fileSize >= start) {
+        size64 = std::min(size64, static_cast<Uint64>(fileSize - start));
+      }
+      m_dataStart = start;
+      m_dataSize = size64 - size64 % m_frameBytes;
+      return true;
+    }
+
+    // chunks are padded to an even size
+    if (SDL_RWseek(m_source, start + size + (size & 1), RW_SEEK_SET) < 0) {
+      break;
+    }
+  }
+
+  std::cerr << "Error reading " << m_name << ": no samples\n";
+  return false;
+}
+
+bool MusicStream::decode() {
+  const size_t written{m_written.load(std::memory_order_relaxed)};
+  // frames a rewind dropped count as used until read() skips them
+  const size_t position{m_read.load(std::memory_order_acquire)};
+  const size_t space{m_capacity - (written - position)};
+  if (space == 0) return false;
+
+  const int available{SDL_AudioStreamAvailable(m_converter)};
+  if (available == 0) {
+    if (m_remaining > 0) {
+      size_t bytes{static_cast<size_t>(
+          std::min<Uint64>(m_remaining, m_input.size()))};
+      if (SDL_RWread(m_source, m_input.data(), bytes, 1) != 1 ||
+          SDL_AudioStreamPut(m_converter, m_input.data(),
+                             static_cast<int>(bytes)) < 0) {
+        // a read error ends the track rather than repeating it
+        std::cerr << "Error decoding " << m_name << ": " << SDL_GetError()
+                  << '\n';
+        m_remaining = 0;
+        m_dataSize = 0;
+        return true;
+      }
+      m_remaining -= bytes;
+      return true;
+    }
+
+    // looping carries straight on so the resampler sees no seam
+    if (m_loop && m_dataSize > 0) {
+      SDL_RWseek(m_source, m_dataStart, RW_SEEK_SET);
+      m_remaining = m_dataSize;
+      return true;
+    }
+    if (!m_flushed) {
+      SDL_AudioStreamFlush(m_converter);
+      m_flushed = true;
+      return true;
+    }
+    m_ended.store(true, std::memory_order_release);
+    return false;
+  }
+
+  const int bytes{static_cast<int>(
+      std::min<size_t>(available, std::min(space, m_decoded.size() / 2) *
+                                      2 * sizeof(Sint16)))};
+  const int got{SDL_AudioStreamGet(m_converter, m_decoded.data(), bytes)};
+  if (got <= 0) return false;
+
+  const size_t frames{static_cast<size_t>(got) / (2 * sizeof(Sint16))};
+  const size_t start{written & (m_capacity - 1)};
+  const size_t first{std::min(frames, m_capacity - start)};
+  std::memcpy(m_ring.data() + start * 2, m_decoded.data(),
+              first * 2 * sizeof(Sint16));
+  std::memcpy(m_ring.data(), m_decoded.data() + first * 2,
+              (frames - first) * 2 * sizeof(Sint16));
+  m_written.store(written + frames, std::memory_order_release);
+  return true;
+}
+
+void MusicStream::restart() {
+  SDL_AudioStreamClear(m_converter);
+  SDL_RWseek(m_source, m_dataStart, RW_SEEK_SET);
+  m_remaining = m_dataSize;
+  m_flushed = false;
+  m_ended.store(false, std::memory_order_release);
+  // whatever is buffered now belongs to the old position
+  m_discardUntil.store(m_written.load(std::memory_order_relaxed));
+  // with no reader to skip them the dropped frames are freed here; either
+  // this sees a voice attach or the voice sees the new discard point
+  if (!m_attached.load()) skipDropped();
+}
+
+bool MusicStream::skipDropped() {
+  const size_t discard{m_discardUntil.load()};
+  size_t position{m_read.load()};
+  while (position < discard) {
+    if (m_read.compare_exchange_weak(position, discard)) return true;
+  }
+  return false;
+}
+
+void MusicStream::work() {
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      if (m_stopping) return;
+      if (m_rewind) {
+        m_rewind = false;
+        restart();
+      }
+    }
+    if (decode()) continue;
+
+    // a full ring (or the end) waits a slice of the lookahead, or until
+    // the dropped frames filling it are skipped
+    const bool dropped{m_read.load() < m_discardUntil.load()};
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_wake.wait_for(lock, std::chrono::milliseconds{m_idleMilliseconds},
+                    [this, dropped] {
+                      return m_stopping || m_rewind ||
+                             (dropped &&
+                              m_read.load() >= m_discardUntil.load());
+                    });
+  }
+}
+
+}  // namespace engine
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assetId.h"
+
+namespace engine {
+
+// plays long tracks without holding them in memory. a decoder thread reads
+// the file a piece at a time, converts it to the mixer's 16 bit stereo and
+// keeps a ring buffer of lookahead seconds filled ahead of playback; the
+// audio callback only copies out of the ring, never decoding or locking.
+// when the ring runs dry mid track the gap is counted as an underrun and
+// update() reports it. reads PCM and float WAV files. played through
+// AudioMixer::playStream(), which must stop using it before close()
+class MusicStream {
+ public:
+  MusicStream() = default;
+  ~MusicStream();
+
+  MusicStream(const MusicStream&) = delete;
+  MusicStream& operator=(const MusicStream&) = delete;
+
+  // decodes the first lookahead before returning, so playback can start
+  // at once; frequency is the mixer's (AudioMixer::getFrequency())
+  bool open(AssetId asset, int frequency, double lookahead = 2.0,
+            bool loop = true);
+  void close();
+
+  // back to the start, audible once the decoder has caught up (well
+  // within one buffer); a stream no voice is reading refills at once
+  void rewind();
+
+  // main thread: reports underruns since the last call to std::cerr
+  void update();
+
+  // audio thread only: copies up to frames stereo frames into output and
+  // returns how many there were
+  int read(Sint16* output, int frames);
+  // the track ended (without looping) and everything was read
+  bool isFinished() const;
+  // audio thread only: AudioMixer marks when a voice starts and stops
+  // reading, one voice at a time
+  void attach();
+  void detach();
+
+  // getters
+  int getUnderruns() const { return m_underruns.load(); }
+  int getBufferedFrames() const;
+  int getCapacityFrames() const { return static_cast<int>(m_capacity); }
+
+ private:
+  // where the samples live in the file
+  bool readHeader();
+  // the decoder's next step, false when there was nothing to do
+  bool decode();
+  void restart();
+  // moves m_read past the frames a rewind dropped, true if it did
+  bool skipDropped();
+  void work();
+
+  std::string m_name;
+  SDL_RWops* m_source{nullptr};
+  SDL_AudioStream* m_converter{nullptr};
+  bool m_loop{true};
+
+  // decoder thread state
+  SDL_AudioFormat m_format{0};
+  int m_channels{0};
+  int m_rate{0};
+  int m_frameBytes{0};
+  Sint64 m_dataStart{0};
+  Uint64 m_dataSize{0};
+  Uint64 m_remaining{0};
+  bool m_flushed{false};
+  std::vector<Uint8> m_input;
+  std::vector<Sint16> m_decoded;
+
+  // the ring, in stereo frames; both indices only ever grow
+  std::vector<Sint16> m_ring;
+  size_t m_capacity{0};
+  std::atomic<size_t> m_written{0};
+  std::atomic<size_t> m_read{0};
+  // frames before this are from before a rewind and still hold their
+  // slots until skipped: by the reader while a voice is attached, else by
+  // whichever of restart() and detach() sees the other's change
+  std::atomic<size_t> m_discardUntil{0};
+  std::atomic<bool> m_attached{false};
+  std::atomic<bool> m_ended{false};
+
+  std::atomic<int> m_underruns{0};
+  int m_reported{0};
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  bool m_stopping{false};
+  bool m_rewind{false};
+  // how long the decoder sleeps on a full ring
+  int m_idleMilliseconds{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,468 @@
+#include "pixelOps.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "simd.h"
+
+namespace engine {
+
+namespace {
+constexpr Uint32 rgbMask{0x00ffffff};
+
+void keyToAlphaScalar(Uint32* pixels, size_t count, Uint32 key) {
+  for (size_t i{0}; i < count; i++) {
+    if ((pixels[i] & rgbMask) == key) pixels[i] &= rgbMask;
+  }
+}
+
+#ifdef ENGINE_SSE2
+void keyToAlphaSSE2(Uint32* pixels, size_t count, Uint32 key) {
+  const __m128i colour{_mm_set1_epi32(static_cast<int>(rgbMask))};
+  const __m128i alpha{_mm_set1_epi32(static_cast<int>(~rgbMask))};
+  const __m128i keyed{_mm_set1_epi32(static_cast<int>(key))};
+
+  size_t i{0};
+  for (; i + 4 <= count; i += 4) {
+    __m128i* at{reinterpret_cast<__m128i*>(pixels + i)};
+    __m128i value{_mm_loadu_si128(at)};
+    __m128i match{_mm_cmpeq_epi32(_mm_and_si128(value, colour), keyed)};
+    _mm_storeu_si128(at, _mm_andnot_si128(_mm_and_si128(match, alpha), value));
+  }
+  keyToAlphaScalar(pixels + i, count - i, key);
+}
+#endif
+
+#ifdef ENGINE_AVX2
+ENGINE_TARGET_AVX2
+void keyToAlphaAVX2(Uint32* pixels, size_t count, Uint32 key) {
+  const __m256i colour{_mm256_set1_epi32(static_cast<int>(rgbMask))};
+  const __m256i alpha{_mm256_set1_epi32(static_cast<int>(~rgbMask))};
+  const __m256i keyed{_mm256_set1_epi32(static_cast<int>(key))};
+
+  size_t i{0};
+  for (; i + 8 <= count; i += 8) {
+    __m256i* at{reinterpret_cast<__m256i*>(pixels + i)};
+    __m256i value{_mm256_loadu_si256(at)};
+    __m256i match{
+        _mm256_cmpeq_epi32(_mm256_and_si256(value, colour), keyed)};
+    _mm256_storeu_si256(
+        at, _mm256_andnot_si256(_mm256_and_si256(match, alpha), value));
+  }
+  keyToAlphaScalar(pixels + i, count - i, key);
+}
+#endif
+
+// nearest: one source row sampled through a precomputed column table
+void gatherScalar(const Uint32* row, const Sint32* columns, Uint32* out,
+                  int count) {
+  for (int x{0}; x < count; x++) out[x] = row[columns[x]];
+}
+
+#ifdef ENGINE_AVX2
+ENGINE_TARGET_AVX2
+void gatherAVX2(const Uint32* row, const Sint32* columns, Uint32* out,
+                int count) {
+  const int* base{reinterpret_cast<const int*>(row)};
+  int x{0};
+  for (; x + 8 <= count; x += 8) {
+    __m256i index{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns + x))};
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x),
+                        _mm256_i32gather_epi32(base, index, 4));
+  }
+  gatherScalar(row, columns + x, out + x, count - x);
+}
+#endif
+
+// bilinear, vertical pass: blends two source rows with weight 0..255 on
+// the second. every path rounds the same way, so results are identical
+void lerpRowsScalar(const Uint32* first, const Uint32* second, int weight,
+                    Uint32* out, int count) {
+  const Uint8* a{reinterpret_cast<const Uint8*>(first)};
+  const Uint8* b{reinterpret_cast<const Uint8*>(second)};
+  Uint8* result{reinterpret_cast<Uint8*>(out)};
+  for (int i{0}; i < count * 4; i++) {
+    result[i] =
+        static_cast<Uint8>((a[i] * (256 - weight) + b[i] * weight) >> 8);
+  }
+}
+
+#ifdef ENGINE_SSE2
+void lerpRowsSSE2(const Uint32* first, const Uint32* second, int weight,
+                  Uint32* out, int count) {
+  const __m128i zero{_mm_setzero_si128()};
+  const __m128i weightA{_mm_set1_epi16(static_cast<short>(256 - weight))};
+  const __m128i weightB{_mm_set1_epi16(static_cast<short>(weight))};
+
+  int x{0};
+  for (; x + 4 <= count; x += 4) {
+    __m128i a{_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + x))};
+    __m128i b{_mm_loadu_si128(reinterpret_cast<const __m128i*>(second + x))};
+    __m128i low{_mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), weightA),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weightB))};
+    __m128i high{_mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), weightA),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weightB))};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+                     _mm_packus_epi16(_mm_srli_epi16(low, 8),
+                                      _mm_srli_epi16(high, 8)));
+  }
+  lerpRowsScalar(first + x, second + x, weight, out + x, count - x);
+}
+
+// bilinear, horizontal pass: each output blends a pixel with its right
+// neighbour, both widened to 16 bits in one register
+void lerpColumnsSSE2(const Uint32* row, const Sint32* columns,
+                     const Uint8* weights, Uint32* out, int count) {
+  const __m128i zero{_mm_setzero_si128()};
+  for (int x{0}; x < count; x++) {
+    short weight{weights[x]};
+    short rest{static_cast<short>(256 - weight)};
+    __m128i pair{_mm_unpacklo_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + columns[x])),
+        zero)};
+    __m128i scaled{_mm_mullo_epi16(
+        pair, _mm_set_epi16(weight, weight, weight, weight, rest, rest, rest,
+                            rest))};
+    __m128i sum{_mm_srli_epi16(
+        _mm_add_epi16(scaled, _mm_srli_si128(scaled, 8)), 8)};
+    out[x] = static_cast<Uint32>(
+        _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum)));
+  }
+}
+#endif
+
+void lerpColumnsScalar(const Uint32* row, const Sint32* columns,
+                       const Uint8* weights, Uint32* out, int count) {
+  for (int x{0}; x < count; x++) {
+    const Uint8* a{reinterpret_cast<const Uint8*>(row + columns[x])};
+    const Uint8* b{a + 4};
+    Uint8* result{reinterpret_cast<Uint8*>(out + x)};
+    int weight{weights[x]};
+    for (int i{0}; i < 4; i++) {
+      result[i] =
+          static_cast<Uint8>((a[i] * (256 - weight) + b[i] * weight) >> 8);
+    }
+  }
+}
+
+#ifdef ENGINE_AVX2
+ENGINE_TARGET_AVX2
+void lerpRowsAVX2(const Uint32* first, const Uint32* second, int weight,
+                  Uint32* out, int count) {
+  const __m256i zero{_mm256_setzero_si256()};
+  const __m256i weightA{_mm256_set1_epi16(static_cast<short>(256 - weight))};
+  const __m256i weightB{_mm256_set1_epi16(static_cast<short>(weight))};
+
+  // unpacking and packing both stay within 128-bit lanes, so the pixel
+  // order comes back unchanged
+  int x{0};
+  for (; x + 8 <= count; x += 8) {
+    __m256i a{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + x))};
+    __m256i b{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + x))};
+    __m256i low{_mm256_add_epi16(
+        _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), weightA),
+        _mm256_mullo_epi16(_mm256_unpacklo_epi8(b, zero), weightB))};
+    __m256i high{_mm256_add_epi16(
+        _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), weightA),
+        _mm256_mullo_epi16(_mm256_unpackhi_epi8(b, zero), weightB))};
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x),
+                        _mm256_packus_epi16(_mm256_srli_epi16(low, 8),
+                                            _mm256_srli_epi16(high, 8)));
+  }
+  lerpRowsScalar(first + x, second + x, weight, out + x, count - x);
+}
+#endif
+
+// box filter: one destination row from two source rows. right is the
+// column paired with the last one, which only differs for 1 pixel wide
+// sources
+void halveRowScalar(const Uint32* first, const Uint32* second, Uint32* out,
+                    int count, int right) {
+  for (int x{0}; x < count; x++) {
+    int left{2 * x};
+    int next{std::min(left + 1, right)};
+    const Uint8* a{reinterpret_cast<const Uint8*>(first + left)};
+    const Uint8* b{reinterpret_cast<const Uint8*>(first + next)};
+    const Uint8* c{reinterpret_cast<const Uint8*>(second + left)};
+    const Uint8* d{reinterpret_cast<const Uint8*>(second + next)};
+    Uint8* result{reinterpret_cast<Uint8*>(out + x)};
+    for (int i{0}; i < 4; i++) {
+      result[i] = static_cast<Uint8>((a[i] + b[i] + c[i] + d[i] + 2) >> 2);
+    }
+  }
+}
+
+#ifdef ENGINE_SSE2
+// four outputs from eight pixels of each row, summed in 16 bits
+void halveRowSSE2(const Uint32* first, const Uint32* second, Uint32* out,
+                  int count, int right) {
+  const __m128i zero{_mm_setzero_si128()};
+  const __m128i round{_mm_set1_epi16(2)};
+
+  int x{0};
+  for (; x + 4 <= count && 2 * x + 8 <= right + 1; x += 4) {
+    const __m128i* a{reinterpret_cast<const __m128i*>(first + 2 * x)};
+    const __m128i* b{reinterpret_cast<const __m128i*>(second + 2 * x)};
+    __m128i a0{_mm_loadu_si128(a)};
+    __m128i a1{_mm_loadu_si128(a + 1)};
+    __m128i b0{_mm_loadu_si128(b)};
+    __m128i b1{_mm_loadu_si128(b + 1)};
+
+    // vertical sums, two source pixels per register
+    __m128i s01{_mm_add_epi16(_mm_unpacklo_epi8(a0, zero),
+                              _mm_unpacklo_epi8(b0, zero))};
+    __m128i s23{_mm_add_epi16(_mm_unpackhi_epi8(a0, zero),
+                              _mm_unpackhi_epi8(b0, zero))};
+    __m128i s45{_mm_add_epi16(_mm_unpacklo_epi8(a1, zero),
+                              _mm_unpacklo_epi8(b1, zero))};
+    __m128i s67{_mm_add_epi16(_mm_unpackhi_epi8(a1, zero),
+                              _mm_unpackhi_epi8(b1, zero))};
+
+    // horizontal sums: pair each even pixel with the odd one after it
+    __m128i low{_mm_add_epi16(_mm_unpacklo_epi64(s01, s23),
+                              _mm_unpackhi_epi64(s01, s23))};
+    __m128i high{_mm_add_epi16(_mm_unpacklo_epi64(s45, s67),
+                               _mm_unpackhi_epi64(s45, s67))};
+    low = _mm_srli_epi16(_mm_add_epi16(low, round), 2);
+    high = _mm_srli_epi16(_mm_add_epi16(high, round), 2);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+                     _mm_packus_epi16(low, high));
+  }
+  halveRowScalar(first + 2 * x, second + 2 * x, out + x, count - x,
+                 right - 2 * x);
+}
+#endif
+
+#ifdef ENGINE_AVX2
+ENGINE_TARGET_AVX2
+void halveRowAVX2(const Uint32* first, const Uint32* second, Uint32* out,
+                  int count, int right) {
+  const __m256i zero{_mm256_setzero_si256()};
+  const __m256i round{_mm256_set1_epi16(2)};
+
+  int x{0};
+  for (; x + 8 <= count && 2 * x + 16 <= right + 1; x += 8) {
+    const __m256i* a{reinterpret_cast<const __m256i*>(first + 2 * x)};
+    const __m256i* b{reinterpret_cast<const __m256i*>(second + 2 * x)};
+    __m256i a0{_mm256_loadu_si256(a)};
+    __m256i a1{_mm256_loadu_si256(a + 1)};
+    __m256i b0{_mm256_loadu_si256(b)};
+    __m256i b1{_mm256_loadu_si256(b + 1)};
+
+    __m256i s0{_mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero),
+                                _mm256_unpacklo_epi8(b0, zero))};
+    __m256i s1{_mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero),
+                                _mm256_unpackhi_epi8(b0, zero))};
+    __m256i s2{_mm256_add_epi16(_mm256_unpacklo_epi8(a1, zero),
+                                _mm256_unpacklo_epi8(b1, zero))};
+    __m256i s3{_mm256_add_epi16(_mm256_unpackhi_epi8(a1, zero),
+                                _mm256_unpackhi_epi8(b1, zero))};
+
+    __m256i low{_mm256_add_epi16(_mm256_unpacklo_epi64(s0, s1),
+                                 _mm256_unpackhi_epi64(s0, s1))};
+    __m256i high{_mm256_add_epi16(_mm256_unpacklo_epi64(s2, s3),
+                                  _mm256_unpackhi_epi64(s2, s3))};
+    low = _mm256_srli_epi16(_mm256_add_epi16(low, round), 2);
+    high = _mm256_srli_epi16(_mm256_add_epi16(high, round), 2);
+
+    // packing works per 128-bit lane, leaving the quarters out of order
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out + x),
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high),
+                                 _MM_SHUFFLE(3, 1, 2, 0)));
+  }
+  halveRowScalar(first + 2 * x, second + 2 * x, out + x, count - x,
+                 right - 2 * x);
+}
+#endif
+
+Uint32* surfaceRow(SDL_Surface* surface, int y) {
+  return reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) +
+                                   y * surface->pitch);
+}
+
+// source position of a destination pixel's centre, in 1/256 pixels
+Sint64 sourcePosition(int index, int sourceSize, int destinationSize) {
+  return ((2 * static_cast<Sint64>(index) + 1) * sourceSize * 256) /
+             (2 * static_cast<Sint64>(destinationSize)) -
+         128;
+}
+
+enum simdPath { simd_scalar, simd_sse2, simd_avx2 };
+
+simdPath detectPath() {
+#ifdef ENGINE_AVX2
+  if (SDL_HasAVX2()) return simd_avx2;
+#endif
+#ifdef ENGINE_SSE2
+  if (SDL_HasSSE2()) return simd_sse2;
+#endif
+  return simd_scalar;
+}
+
+simdPath path() {
+  static const simdPath detected{detectPath()};
+  return detected;
+}
+}  // namespace
+
+void keyToAlpha(Uint32* pixels, size_t count, Uint32 key) {
+  key &= rgbMask;
+  switch (path()) {
+#ifdef ENGINE_AVX2
+    case simd_avx2:
+      keyToAlphaAVX2(pixels, count, key);
+      return;
+#endif
+#ifdef ENGINE_SSE2
+    case simd_sse2:
+      keyToAlphaSSE2(pixels, count, key);
+      return;
+#endif
+    default:
+      keyToAlphaScalar(pixels, count, key);
+  }
+}
+
+void scaleNearest(SDL_Surface* source, SDL_Surface* destination) {
+  const int width{destination->w};
+  if (width <= 0 || source->w <= 0 || source->h <= 0) return;
+
+  std::vector<Sint32> columns(width);
+  for (int x{0}; x < width; x++) {
+    columns[x] = static_cast<Sint32>(
+        (2 * static_cast<Sint64>(x) + 1) * source->w / (2 * width));
+  }
+
+  int previous{-1};
+  for (int y{0}; y < destination->h; y++) {
+    int row{static_cast<int>((2 * static_cast<Sint64>(y) + 1) * source->h /
+                             (2 * destination->h))};
+    Uint32* out{surfaceRow(destination, y)};
+
+    // magnified rows repeat, copy instead of sampling again
+    if (row == previous) {
+      std::memcpy(out, surfaceRow(destination, y - 1), width * 4);
+      continue;
+    }
+    previous = row;
+
+#ifdef ENGINE_AVX2
+    if (path() == simd_avx2) {
+      gatherAVX2(surfaceRow(source, row), columns.data(), out, width);
+      continue;
+    }
+#endif
+    gatherScalar(surfaceRow(source, row), columns.data(), out, width);
+  }
+}
+
+void scaleBilinear(SDL_Surface* source, SDL_Surface* destination) {
+  const int width{destination->w};
+  const int sourceWidth{source->w};
+  if (width <= 0 || sourceWidth <= 0 || source->h <= 0) return;
+
+  std::vector<Sint32> columns(width);
+  std::vector<Uint8> weights(width);
+  for (int x{0}; x < width; x++) {
+    Sint64 position{
+        std::max<Sint64>(sourcePosition(x, sourceWidth, width), 0)};
+    columns[x] = static_cast<Sint32>(
+        std::min<Sint64>(position >> 8, sourceWidth - 1));
+    weights[x] = columns[x] == sourceWidth - 1
+                     ? 0
+                     : static_cast<Uint8>(position & 0xff);
+  }
+
+  // one blended source row plus a copy of its last pixel, so every output
+  // can read a right neighbour
+  std::vector<Uint32> blended(sourceWidth + 1);
+
+  for (int y{0}; y < destination->h; y++) {
+    Sint64 position{
+        std::max<Sint64>(sourcePosition(y, source->h, destination->h), 0)};
+    int first{static_cast<int>(std::min<Sint64>(position >> 8, source->h - 1))};
+    int second{std::min(first + 1, source->h - 1)};
+    int weight{first == second ? 0 : static_cast<int>(position & 0xff)};
+
+    switch (path()) {
+#ifdef ENGINE_AVX2
+      case simd_avx2:
+        lerpRowsAVX2(surfaceRow(source, first), surfaceRow(source, second),
+                     weight, blended.data(), sourceWidth);
+        break;
+#endif
+#ifdef ENGINE_SSE2
+      case simd_sse2:
+        lerpRowsSSE2(surfaceRow(source, first), surfaceRow(source, second),
+                     weight, blended.data(), sourceWidth);
+        break;
+#endif
+      default:
+        lerpRowsScalar(surfaceRow(source, first), surfaceRow(source, second),
+                       weight, blended.data(), sourceWidth);
+    }
+    blended[sourceWidth] = blended[sourceWidth - 1];
+
+    Uint32* out{surfaceRow(destination, y)};
+#ifdef ENGINE_SSE2
+    if (path() != simd_scalar) {
+      lerpColumnsSSE2(blended.data(), columns.data(), weights.data(), out,
+                      width);
+      continue;
+    }
+#endif
+    lerpColumnsScalar(blended.data(), columns.data(), weights.data(), out,
+                      width);
+  }
+}
+
+void halveBox(SDL_Surface* source, SDL_Surface* destination) {
+  if (source->w <= 0 || source->h <= 0) return;
+
+  const int width{std::min(destination->w, std::max(source->w / 2, 1))};
+  const int right{source->w - 1};
+  const int height{std::min(destination->h, std::max(source->h / 2, 1))};
+
+  for (int y{0}; y < height; y++) {
+    const Uint32* first{surfaceRow(source, 2 * y)};
+    const Uint32* second{
+        surfaceRow(source, std::min(2 * y + 1, source->h - 1))};
+    Uint32* out{surfaceRow(destination, y)};
+
+    switch (path()) {
+#ifdef ENGINE_AVX2
+      case simd_avx2:
+        halveRowAVX2(first, second, out, width, right);
+        break;
+#endif
+#ifdef ENGINE_SSE2
+      case simd_sse2:
+        halveRowSSE2(first, second, out, width, right);
+        break;
+#endif
+      default:
+        halveRowScalar(first, second, out, width, right);
+    }
+  }
+}
+
+const char* pixelOpsPath() {
+  switch (path()) {
+    case simd_avx2:
+      return "avx2";
+    case simd_sse2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace engine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+
+namespace engine {
+
+// kernels over 32-bit pixels, each with a scalar version and SSE2/AVX2
+// versions chosen once at run time from what the CPU supports
+
+// clears alpha on every pixel whose colour is key (0xRRGGBB), leaving the
+// rest untouched. pixels are ARGB8888
+void keyToAlpha(Uint32* pixels, size_t count, Uint32 key);
+
+// stretch source over all of destination. both surfaces must be 32 bits
+// per pixel in the same format; channels are treated alike, so any such
+// format works. texel centres are aligned like SDL's own scalers
+void scaleNearest(SDL_Surface* source, SDL_Surface* destination);
+void scaleBilinear(SDL_Surface* source, SDL_Surface* destination);
+
+// one mip step: every destination pixel is the rounded average of a 2x2
+// source block. destination should be max(1, w / 2) x max(1, h / 2) of the
+// source, in the same 32-bit format; an odd last row or column is dropped
+void halveBox(SDL_Surface* source, SDL_Surface* destination);
+
+// the path the kernels run on: "avx2", "sse2" or "scalar"
+const char* pixelOpsPath();
+
+}  // namespace engine
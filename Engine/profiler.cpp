@@ -0,0 +1,172 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace engine {
+
+namespace {
+constexpr int historyLength{240};
+
+// the graph is two 60 Hz frames tall with a line at one
+constexpr double graphMilliseconds{1000.0 / 30.0};
+constexpr double budgetMilliseconds{1000.0 / 60.0};
+}  // namespace
+
+Profiler::Profiler()
+    : m_ticksToMs{1000.0 /
+                  static_cast<double>(SDL_GetPerformanceFrequency())} {
+  m_other = addPhase("other", SDL_Color{0x80, 0x80, 0x80, 0xff});
+}
+
+int Profiler::addPhase(const std::string& name, SDL_Color color) {
+  m_phases.push_back(Phase{name, color});
+
+  // the history layout depends on the phase count, so start it again
+  m_current.assign(m_phases.size(), 0.0);
+  m_history.assign(historyLength * m_phases.size(), 0.0f);
+  m_newest = -1;
+  m_frames = 0;
+
+  return static_cast<int>(m_phases.size()) - 1;
+}
+
+void Profiler::charge(Uint64 now) {
+  if (!m_open.empty()) {
+    m_current[m_open.back()] += (now - m_lastCounter) * m_ticksToMs;
+  }
+  m_lastCounter = now;
+}
+
+void Profiler::begin(int phase) {
+  Uint64 now{SDL_GetPerformanceCounter()};
+  if (m_frameStart == 0) m_frameStart = now;
+
+  charge(now);
+  m_open.push_back(phase);
+}
+
+void Profiler::end() {
+  if (m_open.empty()) return;
+
+  charge(SDL_GetPerformanceCounter());
+  m_open.pop_back();
+}
+
+void Profiler::endFrame() {
+  Uint64 now{SDL_GetPerformanceCounter()};
+
+  // the first frame would include loading, so it only starts the clock
+  if (m_frameStart == 0) {
+    m_frameStart = now;
+    m_lastCounter = now;
+    return;
+  }
+
+  charge(now);
+
+  double total{(now - m_frameStart) * m_ticksToMs};
+  double covered{0.0};
+  for (double time : m_current) covered += time;
+  m_current[m_other] += std::max(0.0, total - covered);
+
+  m_newest = (m_newest + 1) % historyLength;
+  m_frames = std::min(m_frames + 1, historyLength);
+
+  size_t count{m_phases.size()};
+  for (size_t i{0}; i < count; i++) {
+    m_history[m_newest * count + i] = static_cast<float>(m_current[i]);
+    m_current[i] = 0.0;
+  }
+
+  m_frameStart = now;
+}
+
+bool Profiler::handleEvent(const SDL_Event& event) {
+  if (event.type != SDL_KEYDOWN || event.key.repeat ||
+      event.key.keysym.sym != m_toggleKey) {
+    return false;
+  }
+
+  m_visible = !m_visible;
+  return true;
+}
+
+double Profiler::average(int phase) const {
+  if (m_frames == 0) return 0.0;
+
+  size_t count{m_phases.size()};
+  double total{0.0};
+  for (int age{0}; age < m_frames; age++) {
+    int frame{(m_newest - age + historyLength) % historyLength};
+    total += m_history[frame * count + phase];
+  }
+  return total / m_frames;
+}
+
+void Profiler::render(SDL_Renderer* renderer, const SDL_Rect& area,
+                      SpriteBatch* batch, GlyphAtlas* labels) {
+  if (!m_visible || m_frames == 0 || area.w <= 0 || area.h <= 0) return;
+
+  Uint8 r{}, g{}, b{}, a{};
+  SDL_BlendMode blending{};
+  SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+  SDL_GetRenderDrawBlendMode(renderer, &blending);
+
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xa0);
+  SDL_RenderFillRect(renderer, &area);
+
+  // every frame's stack is built first so each phase is one fill call
+  size_t count{m_phases.size()};
+  m_bars.resize(count * m_frames);
+
+  int columnWidth{std::max(1, area.w / historyLength)};
+  double pixelsPerMs{area.h / graphMilliseconds};
+  int bottom{area.y + area.h};
+
+  for (int age{0}; age < m_frames; age++) {
+    int frame{(m_newest - age + historyLength) % historyLength};
+    int x{area.x + area.w - (age + 1) * columnWidth};
+    if (x < area.x) break;
+
+    double stacked{0.0};
+    for (size_t i{0}; i < count; i++) {
+      int top{static_cast<int>(stacked * pixelsPerMs)};
+      stacked += m_history[frame * count + i];
+      int height{std::min(static_cast<int>(stacked * pixelsPerMs), area.h) -
+                 std::min(top, area.h)};
+      m_bars[i * m_frames + age] =
+          SDL_Rect{x, bottom - top - height, columnWidth, height};
+    }
+  }
+
+  int columns{std::min(m_frames, area.w / columnWidth)};
+  for (size_t i{0}; i < count; i++) {
+    const SDL_Color& color{m_phases[i].color};
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 0xff);
+    SDL_RenderFillRects(renderer, &m_bars[i * m_frames], columns);
+  }
+
+  int budget{bottom - static_cast<int>(budgetMilliseconds * pixelsPerMs)};
+  SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 0xff);
+  SDL_RenderDrawLine(renderer, area.x, budget, area.x + area.w - 1, budget);
+
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+  SDL_SetRenderDrawBlendMode(renderer, blending);
+
+  if (!batch || !labels) return;
+
+  // legend, topmost phase of the stack first
+  char text[64];
+  int y{area.y + 4};
+  for (size_t i{count}; i-- > 0;) {
+    std::snprintf(text, sizeof(text), "%s %.2f ms", m_phases[i].name.c_str(),
+                  average(static_cast<int>(i)));
+    labels->draw(*batch, text, area.x + 4, y, m_phases[i].color);
+    y += labels->getLineHeight();
+  }
+  batch->flush();
+}
+
+}  // namespace engine
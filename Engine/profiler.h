@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <vector>
+
+#include "glyphAtlas.h"
+#include "spriteBatch.h"
+
+namespace engine {
+
+// times named phases of the main loop with SDL_GetPerformanceCounter and
+// keeps a rolling history that can be drawn as a stacked graph over the
+// scene. nested phases are exclusive: time spent in an inner phase is not
+// charged to the one around it, so the stack adds up to the frame
+class Profiler {
+ public:
+  Profiler();
+
+  // returns the id used with begin() and ProfileScope
+  int addPhase(const std::string& name, SDL_Color color);
+
+  void begin(int phase);
+  void end();
+
+  // closes the frame; whatever no phase covered is shown as "other"
+  void endFrame();
+
+  // toggles the overlay, true when the event was the toggle key
+  bool handleEvent(const SDL_Event& event);
+  void setToggleKey(SDL_Keycode key) { m_toggleKey = key; }
+  bool isVisible() const { return m_visible; }
+
+  // one column per frame, newest on the right; labels are drawn with the
+  // glyphs through the batch when both are given, which is then flushed
+  void render(SDL_Renderer* renderer, const SDL_Rect& area,
+              SpriteBatch* batch = nullptr, GlyphAtlas* labels = nullptr);
+
+  // milliseconds averaged over the history
+  double average(int phase) const;
+
+ private:
+  struct Phase {
+    std::string name;
+    SDL_Color color;
+  };
+
+  // time since the last charge goes to the innermost open phase
+  void charge(Uint64 now);
+
+  std::vector<Phase> m_phases;
+  int m_other{};
+
+  std::vector<int> m_open;
+  Uint64 m_lastCounter{};
+  Uint64 m_frameStart{};
+  double m_ticksToMs{};
+
+  // milliseconds per phase for this frame, then history ring of frames
+  std::vector<double> m_current;
+  std::vector<float> m_history;
+  int m_newest{-1};
+  int m_frames{};
+
+  std::vector<SDL_Rect> m_bars;
+
+  SDL_Keycode m_toggleKey{SDLK_F3};
+  bool m_visible{false};
+};
+
+// times the enclosing block as one phase
+class ProfileScope {
+ public:
+  ProfileScope(Profiler& profiler, int phase) : m_profiler{profiler} {
+    m_profiler.begin(phase);
+  }
+  ~ProfileScope() { m_profiler.end(); }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+  Profiler& m_profiler;
+};
+
+}  // namespace engine
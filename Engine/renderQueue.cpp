@@ -0,0 +1,256 @@
+#include "renderQueue.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace engine {
+
+namespace {
+// commands reserved up front so typical frames never reallocate
+constexpr size_t initialCommands{1024};
+
+// four bits of the sort key, custom blend modes share the last slot
+Uint64 blendIndex(SDL_BlendMode blending) {
+  switch (blending) {
+    case SDL_BLENDMODE_NONE:
+      return 0;
+    case SDL_BLENDMODE_BLEND:
+      return 1;
+    case SDL_BLENDMODE_ADD:
+      return 2;
+    case SDL_BLENDMODE_MOD:
+      return 3;
+    case SDL_BLENDMODE_MUL:
+      return 4;
+    default:
+      return 15;
+  }
+}
+
+bool sameColor(SDL_Color a, SDL_Color b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+}  // namespace
+
+RenderQueue::RenderQueue(SDL_Renderer* renderer) : m_renderer{renderer} {
+  m_queue.reserve(initialCommands);
+  m_order.reserve(initialCommands);
+}
+
+void RenderQueue::setRenderer(SDL_Renderer* renderer) {
+  flush();
+  m_renderer = renderer;
+}
+
+Uint64 RenderQueue::sortKey(Uint8 layer, SDL_Texture* texture,
+                            SDL_BlendMode blending, SDL_Color tint) {
+  // textures are numbered in order of first use so the sort stays
+  // deterministic instead of following pointer values
+  Uint32 id{static_cast<Uint32>(m_textureIds.size())};
+  id = m_textureIds.emplace(texture, id).first->second;
+
+  // layer:8 | blend:4 | texture:20 | tint:32
+  Uint64 colour{(static_cast<Uint64>(tint.r) << 24) |
+                (static_cast<Uint64>(tint.g) << 16) |
+                (static_cast<Uint64>(tint.b) << 8) | tint.a};
+  return (static_cast<Uint64>(layer) << 56) | (blendIndex(blending) << 52) |
+         (static_cast<Uint64>(id & 0xfffff) << 32) | colour;
+}
+
+void RenderQueue::submit(Uint8 layer, SDL_Texture* texture,
+                         const SDL_FRect& destination, const SDL_Rect* clip,
+                         SDL_Color tint, SDL_BlendMode blending, double angle,
+                         const SDL_FPoint* centre, SDL_RendererFlip flip) {
+  if (!texture) return;
+
+  Command command;
+  command.texture = texture;
+  command.blending = blending;
+  command.tint = tint;
+  command.destination = destination;
+  command.clipped = clip != nullptr;
+  command.clip = clip ? *clip : SDL_Rect{};
+  command.angle = angle;
+  command.centred = centre != nullptr;
+  command.centre = centre ? *centre : SDL_FPoint{};
+  command.flip = flip;
+
+  SortEntry entry;
+  entry.key = sortKey(layer, texture, blending, tint);
+  entry.index = static_cast<Uint32>(m_queue.size());
+
+  m_queue.push_back(command);
+  m_order.push_back(entry);
+}
+
+void RenderQueue::submit(Uint8 layer, const Texture& texture, int x, int y,
+                         const SDL_Rect* clip, SDL_Color tint,
+                         SDL_BlendMode blending, double angle,
+                         const SDL_Point* centre, SDL_RendererFlip flip) {
+  if (!clip) clip = texture.getContent();
+
+  SDL_FRect destination{static_cast<float>(x), static_cast<float>(y),
+                        static_cast<float>(texture.getWidth()),
+                        static_cast<float>(texture.getHeight())};
+  if (clip) {
+    destination.w = static_cast<float>(clip->w);
+    destination.h = static_cast<float>(clip->h);
+  }
+
+  SDL_FPoint floatCentre{};
+  if (centre) {
+    floatCentre.x = static_cast<float>(centre->x);
+    floatCentre.y = static_cast<float>(centre->y);
+  }
+
+  submit(layer, texture.get(), destination, clip, tint, blending, angle,
+         centre ? &floatCentre : nullptr, flip);
+}
+
+void RenderQueue::submit(Uint8 layer, const Texture& texture,
+                         const SDL_Rect& destination, const SDL_Rect* clip,
+                         SDL_Color tint, SDL_BlendMode blending) {
+  if (!clip) clip = texture.getContent();
+
+  // mipmapped textures are drawn from the level Texture::render would use
+  SDL_Rect levelClip;
+  SDL_Texture* level{
+      texture.selectLevel(clip, destination.w, destination.h, levelClip)};
+
+  SDL_FRect floatDestination{
+      static_cast<float>(destination.x), static_cast<float>(destination.y),
+      static_cast<float>(destination.w), static_cast<float>(destination.h)};
+  submit(layer, level, floatDestination, &levelClip, tint, blending);
+}
+
+void RenderQueue::sort() {
+  // the index breaks ties, keeping submission order within a key
+  std::sort(m_order.begin(), m_order.end(),
+            [](const SortEntry& a, const SortEntry& b) {
+              return a.key != b.key ? a.key < b.key : a.index < b.index;
+            });
+}
+
+void RenderQueue::clear() {
+  m_queue.clear();
+  m_order.clear();
+  m_textureIds.clear();
+  m_applied.clear();
+}
+
+void RenderQueue::flush() {
+  if (m_queue.empty()) return;
+
+  // what submission order would have cost: every texture, blend or tint
+  // switch between neighbouring draws
+  const Command* previous{nullptr};
+  for (const Command& command : m_queue) {
+    if (!previous || command.texture != previous->texture ||
+        command.blending != previous->blending ||
+        !sameColor(command.tint, previous->tint)) {
+      m_unsortedChanges++;
+    }
+    previous = &command;
+  }
+
+  sort();
+
+  previous = nullptr;
+  for (const SortEntry& entry : m_order) {
+    const Command& command{m_queue[entry.index]};
+
+    if (!previous || command.texture != previous->texture ||
+        command.blending != previous->blending ||
+        !sameColor(command.tint, previous->tint)) {
+      m_stateChanges++;
+    }
+    previous = &command;
+
+    // texture state outlives the frame, but only what this flush set is
+    // trusted since anything else may have changed it in between
+    auto applied = m_applied.find(command.texture);
+    if (applied == m_applied.end()) {
+      applied = m_applied.emplace(command.texture, TextureState{}).first;
+      SDL_SetTextureBlendMode(command.texture, command.blending);
+    } else if (applied->second.blending != command.blending) {
+      SDL_SetTextureBlendMode(command.texture, command.blending);
+    }
+    applied->second.blending = command.blending;
+
+    if (!applied->second.tinted ||
+        !sameColor(applied->second.tint, command.tint)) {
+      SDL_SetTextureColorMod(command.texture, command.tint.r, command.tint.g,
+                             command.tint.b);
+      SDL_SetTextureAlphaMod(command.texture, command.tint.a);
+      applied->second.tint = command.tint;
+      applied->second.tinted = true;
+    }
+
+    if (SDL_RenderCopyExF(m_renderer, command.texture,
+                          command.clipped ? &command.clip : NULL,
+                          &command.destination, command.angle,
+                          command.centred ? &command.centre : NULL,
+                          command.flip) != 0) {
+      std::cerr << "Error drawing queued texture: " << SDL_GetError() << '\n';
+    }
+    m_commands++;
+  }
+
+  clear();
+}
+
+void RenderQueue::flush(SpriteBatch& batch) {
+  if (m_queue.empty()) {
+    batch.flush();
+    return;
+  }
+
+  // tint is a vertex colour in a batch, so only texture and blend count
+  const Command* previous{nullptr};
+  for (const Command& command : m_queue) {
+    if (!previous || command.texture != previous->texture ||
+        command.blending != previous->blending) {
+      m_unsortedChanges++;
+    }
+    previous = &command;
+  }
+
+  sort();
+
+  previous = nullptr;
+  for (const SortEntry& entry : m_order) {
+    const Command& command{m_queue[entry.index]};
+
+    if (!previous || command.texture != previous->texture ||
+        command.blending != previous->blending) {
+      m_stateChanges++;
+
+      // the batch must draw what it holds before the blend mode moves
+      auto applied = m_applied.find(command.texture);
+      if (applied == m_applied.end() ||
+          applied->second.blending != command.blending) {
+        batch.flush();
+        SDL_SetTextureBlendMode(command.texture, command.blending);
+        m_applied[command.texture].blending = command.blending;
+      }
+    }
+    previous = &command;
+
+    batch.draw(command.texture, command.destination,
+               command.clipped ? &command.clip : nullptr, command.angle,
+               command.centred ? &command.centre : nullptr, command.flip,
+               command.tint);
+    m_commands++;
+  }
+
+  batch.flush();
+  clear();
+}
+
+void RenderQueue::resetStats() {
+  m_commands = 0;
+  m_stateChanges = 0;
+  m_unsortedChanges = 0;
+}
+
+}  // namespace engine
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "spriteBatch.h"
+#include "texture.h"
+
+namespace engine {
+
+// records draws for a frame and submits them sorted by layer, blend mode,
+// texture and tint so each piece of state is set as few times as possible;
+// lower layers draw first, draws sharing a sort key keep submission order
+class RenderQueue {
+ public:
+  explicit RenderQueue(SDL_Renderer* renderer = nullptr);
+
+  void setRenderer(SDL_Renderer* renderer);
+
+  // same placement rules as SDL_RenderCopyExF, tint replaces the colour and
+  // alpha mods that would otherwise be set on the texture beforehand
+  void submit(Uint8 layer, SDL_Texture* texture, const SDL_FRect& destination,
+              const SDL_Rect* clip = nullptr,
+              SDL_Color tint = SDL_Color{0xff, 0xff, 0xff, 0xff},
+              SDL_BlendMode blending = SDL_BLENDMODE_BLEND,
+              double angle = 0.0, const SDL_FPoint* centre = nullptr,
+              SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+  // mirrors Texture::render, drawing at the clip's (or texture's) size
+  void submit(Uint8 layer, const Texture& texture, int x, int y,
+              const SDL_Rect* clip = nullptr,
+              SDL_Color tint = SDL_Color{0xff, 0xff, 0xff, 0xff},
+              SDL_BlendMode blending = SDL_BLENDMODE_BLEND,
+              double angle = 0.0, const SDL_Point* centre = nullptr,
+              SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+  // mirrors Texture::render, stretched to the destination rectangle
+  void submit(Uint8 layer, const Texture& texture,
+              const SDL_Rect& destination, const SDL_Rect* clip = nullptr,
+              SDL_Color tint = SDL_Color{0xff, 0xff, 0xff, 0xff},
+              SDL_BlendMode blending = SDL_BLENDMODE_BLEND);
+
+  // draws everything with SDL_RenderCopyExF, setting texture state lazily
+  void flush();
+
+  // feeds everything through a sprite batch, where tint is free and only
+  // texture and blend changes cost a draw call; the batch is flushed too
+  void flush(SpriteBatch& batch);
+
+  // commands drawn, state changes made and the changes the same commands
+  // would have needed in submission order, all since the last resetStats()
+  int getCommands() const { return m_commands; }
+  int getStateChanges() const { return m_stateChanges; }
+  int getStateChangesSaved() const {
+    return m_unsortedChanges - m_stateChanges;
+  }
+  void resetStats();
+
+ private:
+  struct Command {
+    SDL_Texture* texture;
+    SDL_BlendMode blending;
+    SDL_Color tint;
+    SDL_FRect destination;
+    SDL_Rect clip;
+    bool clipped;
+    double angle;
+    SDL_FPoint centre;
+    bool centred;
+    SDL_RendererFlip flip;
+  };
+
+  struct SortEntry {
+    Uint64 key;
+    Uint32 index;
+  };
+
+  // texture state as last set during this flush
+  struct TextureState {
+    SDL_BlendMode blending;
+    SDL_Color tint;
+    bool tinted;
+  };
+
+  Uint64 sortKey(Uint8 layer, SDL_Texture* texture, SDL_BlendMode blending,
+                 SDL_Color tint);
+  void sort();
+  void clear();
+
+  SDL_Renderer* m_renderer{nullptr};
+
+  std::vector<Command> m_queue;
+  std::vector<SortEntry> m_order;
+  std::unordered_map<SDL_Texture*, Uint32> m_textureIds;
+  std::unordered_map<SDL_Texture*, TextureState> m_applied;
+
+  int m_commands{};
+  int m_stateChanges{};
+  int m_unsortedChanges{};
+};
+
+}  // namespace engine
@@ -0,0 +1,162 @@
+#include "resourceRegistry.h"
+
+#include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assetPack.h"
+#include "textureCache.h"
+
+namespace engine {
+
+bool ResourceRegistry::Key::operator<(const Key& other) const {
+  return std::tie(kind, hash, size, variant) <
+         std::tie(other.kind, other.hash, other.size, other.variant);
+}
+
+ResourceRegistry::ResourceRegistry(SDL_Renderer* renderer)
+    : m_renderer{renderer} {}
+
+void ResourceRegistry::setRenderer(SDL_Renderer* renderer) {
+  if (renderer == m_renderer) return;
+  m_renderer = renderer;
+
+  // existing textures stay with whoever holds them, but are not handed
+  // out for the new renderer
+  for (auto it = m_resources.begin(); it != m_resources.end();) {
+    if (it->first.kind == resource_texture) {
+      it = m_resources.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::shared_ptr<void> ResourceRegistry::find(resourceKind kind,
+                                             AssetId asset, int variant,
+                                             std::vector<Uint8>& bytes,
+                                             Key& key) {
+  key = Key{kind, 0, 0, variant};
+
+  // an asset seen before skips reading the file while its resource lives
+  auto known = m_contents.find(asset.hash());
+  if (known != m_contents.end()) {
+    if (!samePath(known->second.path.c_str(), asset.path())) {
+      std::cerr << "Asset id collision: " << asset.path() << " and "
+                << known->second.path << '\n';
+      return nullptr;
+    }
+
+    key.hash = known->second.hash;
+    key.size = known->second.size;
+    std::shared_ptr<void> resource{lookup(key)};
+    if (resource) return resource;
+  }
+
+  if (!readAsset(asset, bytes)) return nullptr;
+  key.hash = hashBytes(bytes.data(), bytes.size());
+  key.size = bytes.size();
+  m_contents[asset.hash()] = Content{key.hash, key.size, asset.path()};
+
+  return lookup(key);
+}
+
+std::shared_ptr<void> ResourceRegistry::lookup(const Key& key) {
+  auto found = m_resources.find(key);
+  if (found == m_resources.end()) return nullptr;
+
+  std::shared_ptr<void> resource{found->second.lock()};
+  if (resource) {
+    m_shared++;
+  } else {
+    m_resources.erase(found);
+  }
+  return resource;
+}
+
+void ResourceRegistry::store(const Key& key,
+                             const std::shared_ptr<void>& resource) {
+  // a dead entry still pins its make_shared allocation, so each load also
+  // drops the ones no lookup came back for
+  for (auto it = m_resources.begin(); it != m_resources.end();) {
+    if (it->second.expired()) {
+      it = m_resources.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  m_resources[key] = resource;
+  m_loads++;
+}
+
+SharedTexture ResourceRegistry::loadTexture(AssetId asset, bool mipmapped) {
+  std::vector<Uint8> bytes;
+  Key key;
+  std::shared_ptr<void> existing{
+      find(resource_texture, asset, mipmapped ? 1 : 0, bytes, key)};
+  if (existing) return std::static_pointer_cast<Texture>(existing);
+  if (bytes.empty()) return nullptr;
+
+  SurfaceHandle surface{loadCachedImage(asset, bytes, key.hash,
+                                        preferredFormat(m_renderer))};
+  if (!surface) return nullptr;
+
+  SharedTexture texture{std::make_shared<Texture>()};
+  if (!texture->loadSurface(m_renderer, surface.get(), mipmapped)) {
+    return nullptr;
+  }
+
+  store(key, texture);
+  return texture;
+}
+
+SharedFont ResourceRegistry::loadFont(AssetId asset, int pointSize) {
+  std::vector<Uint8> bytes;
+  Key key;
+  std::shared_ptr<void> existing{
+      find(resource_font, asset, pointSize, bytes, key)};
+  if (existing) return std::static_pointer_cast<TTF_Font>(existing);
+  if (bytes.empty()) return nullptr;
+
+  // freetype reads glyphs from the bytes for as long as the font is open,
+  // so the handle keeps them alive
+  std::shared_ptr<std::vector<Uint8>> data{
+      std::make_shared<std::vector<Uint8>>(std::move(bytes))};
+  TTF_Font* font{TTF_OpenFontRW(
+      SDL_RWFromConstMem(data->data(), static_cast<int>(data->size())), 1,
+      pointSize)};
+  if (!font) {
+    std::cerr << "Error loading " << asset.path() << ": " << TTF_GetError()
+              << '\n';
+    return nullptr;
+  }
+
+  SharedFont shared{font, [data](TTF_Font* open) { TTF_CloseFont(open); }};
+  store(key, shared);
+  return shared;
+}
+
+SharedChunk ResourceRegistry::loadChunk(AssetId asset) {
+  std::vector<Uint8> bytes;
+  Key key;
+  std::shared_ptr<void> existing{find(resource_chunk, asset, 0, bytes, key)};
+  if (existing) return std::static_pointer_cast<Mix_Chunk>(existing);
+  if (bytes.empty()) return nullptr;
+
+  // decoded in full, the bytes can go right after
+  Mix_Chunk* chunk{Mix_LoadWAV_RW(
+      SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size())), 1)};
+  if (!chunk) {
+    std::cerr << "Error loading " << asset.path() << ": " << Mix_GetError()
+              << '\n';
+    return nullptr;
+  }
+
+  SharedChunk shared{chunk, ChunkDeleter{}};
+  store(key, shared);
+  return shared;
+}
+
+}  // namespace engine
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "assetId.h"
+#include "texture.h"
+
+namespace engine {
+
+// handles shared by everything that loaded the same content; the resource
+// is freed with the last one
+using SharedTexture = std::shared_ptr<Texture>;
+using SharedFont = std::shared_ptr<TTF_Font>;
+using SharedChunk = std::shared_ptr<Mix_Chunk>;
+
+// hands out shared handles so every user of one asset costs one decode
+// and one allocation. lookups go by asset id first and then by a hash of
+// the file's bytes, so copies of a file under other names are shared as
+// well. the registry only holds weak references; main thread only
+class ResourceRegistry {
+ public:
+  explicit ResourceRegistry(SDL_Renderer* renderer = nullptr);
+
+  ResourceRegistry(const ResourceRegistry&) = delete;
+  ResourceRegistry& operator=(const ResourceRegistry&) = delete;
+
+  // textures made after this belong to renderer
+  void setRenderer(SDL_Renderer* renderer);
+
+  // null handles when loading fails, reported to std::cerr
+  SharedTexture loadTexture(AssetId asset, bool mipmapped = false);
+  SharedFont loadFont(AssetId asset, int pointSize);
+  SharedChunk loadChunk(AssetId asset);
+
+  // decodes done, and requests answered with an existing resource
+  int getLoads() const { return m_loads; }
+  int getShared() const { return m_shared; }
+
+ private:
+  enum resourceKind { resource_texture, resource_font, resource_chunk };
+
+  struct Content {
+    Uint64 hash;
+    Uint64 size;
+    // the path first read under this id, to catch two paths sharing it
+    std::string path;
+  };
+
+  struct Key {
+    resourceKind kind;
+    Uint64 hash;
+    Uint64 size;
+    // mipmapping for textures, point size for fonts
+    int variant;
+
+    bool operator<(const Key& other) const;
+  };
+
+  // the live resource for an asset, or null with bytes and key filled in
+  // so the caller can decode it and store() the result
+  std::shared_ptr<void> find(resourceKind kind, AssetId asset, int variant,
+                             std::vector<Uint8>& bytes, Key& key);
+  // the live resource for key, erasing the entry when it has died
+  std::shared_ptr<void> lookup(const Key& key);
+  void store(const Key& key, const std::shared_ptr<void>& resource);
+
+  SDL_Renderer* m_renderer{nullptr};
+  // what each asset held when it was last read
+  std::unordered_map<Uint64, Content, AssetIdHash> m_contents;
+  std::map<Key, std::weak_ptr<void>> m_resources;
+
+  int m_loads{0};
+  int m_shared{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,23 @@
+#pragma once
+
+// which vector paths this compiler can build. SSE2 is part of every x86-64
+// target so it is used unconditionally there; AVX2 kernels are compiled
+// separately and only picked at run time when SDL_HasAVX2() says so
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(ENGINE_SSE2) && \
+    (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define ENGINE_AVX2 1
+#include <immintrin.h>
+#endif
+
+// gcc and clang need the instruction set named on each AVX2 function
+#if defined(ENGINE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ENGINE_TARGET_AVX2
+#endif
@@ -0,0 +1,130 @@
+#include "spriteBatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace engine {
+
+namespace {
+constexpr double degreesToRadians{3.14159265358979323846 / 180.0};
+
+// quads reserved up front so typical frames never reallocate
+constexpr size_t initialQuads{1024};
+}  // namespace
+
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer) : m_renderer{renderer} {
+  m_vertices.reserve(initialQuads * 4);
+  m_indices.reserve(initialQuads * 6);
+}
+
+void SpriteBatch::setRenderer(SDL_Renderer* renderer) {
+  flush();
+  m_renderer = renderer;
+}
+
+void SpriteBatch::bind(SDL_Texture* texture) {
+  if (texture == m_texture) return;
+
+  flush();
+  m_texture = texture;
+
+  int width{}, height{};
+  if (texture) SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+  m_textureWidth = static_cast<float>(width);
+  m_textureHeight = static_cast<float>(height);
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_FRect& destination,
+                       const SDL_Rect* clip, double angle,
+                       const SDL_FPoint* centre, SDL_RendererFlip flip,
+                       SDL_Color tint) {
+  bind(texture);
+  if (!m_texture || m_textureWidth <= 0 || m_textureHeight <= 0) return;
+
+  // texture coordinates of the clip, swapped to flip
+  float u0{0.0f}, v0{0.0f}, u1{1.0f}, v1{1.0f};
+  if (clip) {
+    u0 = clip->x / m_textureWidth;
+    v0 = clip->y / m_textureHeight;
+    u1 = (clip->x + clip->w) / m_textureWidth;
+    v1 = (clip->y + clip->h) / m_textureHeight;
+  }
+  if (flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+  if (flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+  // corners relative to the rotation centre, clockwise from top left
+  float cx{centre ? centre->x : destination.w * 0.5f};
+  float cy{centre ? centre->y : destination.h * 0.5f};
+  float xs[4]{-cx, destination.w - cx, destination.w - cx, -cx};
+  float ys[4]{-cy, -cy, destination.h - cy, destination.h - cy};
+  const float us[4]{u0, u1, u1, u0};
+  const float vs[4]{v0, v0, v1, v1};
+
+  float cosine{1.0f}, sine{0.0f};
+  if (angle != 0.0) {
+    cosine = static_cast<float>(std::cos(angle * degreesToRadians));
+    sine = static_cast<float>(std::sin(angle * degreesToRadians));
+  }
+
+  int first{static_cast<int>(m_vertices.size())};
+  for (int i{0}; i < 4; i++) {
+    SDL_Vertex vertex;
+    vertex.position.x = destination.x + cx + xs[i] * cosine - ys[i] * sine;
+    vertex.position.y = destination.y + cy + xs[i] * sine + ys[i] * cosine;
+    vertex.color = tint;
+    vertex.tex_coord.x = us[i];
+    vertex.tex_coord.y = vs[i];
+    m_vertices.push_back(vertex);
+  }
+
+  const int quadIndices[6]{0, 1, 2, 0, 2, 3};
+  for (int index : quadIndices) m_indices.push_back(first + index);
+
+  m_quads++;
+}
+
+void SpriteBatch::draw(const Texture& texture, int x, int y,
+                       const SDL_Rect* clip, double angle,
+                       const SDL_Point* centre, SDL_RendererFlip flip,
+                       SDL_Color tint) {
+  if (!clip) clip = texture.getContent();
+
+  SDL_FRect destination{static_cast<float>(x), static_cast<float>(y),
+                        static_cast<float>(texture.getWidth()),
+                        static_cast<float>(texture.getHeight())};
+  if (clip) {
+    destination.w = static_cast<float>(clip->w);
+    destination.h = static_cast<float>(clip->h);
+  }
+
+  SDL_FPoint floatCentre{};
+  if (centre) {
+    floatCentre.x = static_cast<float>(centre->x);
+    floatCentre.y = static_cast<float>(centre->y);
+  }
+
+  draw(texture.get(), destination, clip, angle, centre ? &floatCentre : nullptr,
+       flip, tint);
+}
+
+void SpriteBatch::flush() {
+  if (m_indices.empty()) return;
+
+  if (SDL_RenderGeometry(m_renderer, m_texture, m_vertices.data(),
+                         static_cast<int>(m_vertices.size()), m_indices.data(),
+                         static_cast<int>(m_indices.size())) != 0) {
+    std::cerr << "Error drawing sprite batch: " << SDL_GetError() << '\n';
+  }
+
+  m_drawCalls++;
+  m_vertices.clear();
+  m_indices.clear();
+}
+
+void SpriteBatch::resetStats() {
+  m_drawCalls = 0;
+  m_quads = 0;
+}
+
+}  // namespace engine
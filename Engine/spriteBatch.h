@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "texture.h"
+
+namespace engine {
+
+// collects textured quads and draws each run sharing a texture with one
+// SDL_RenderGeometry call; rotation and flips are baked into the vertices
+class SpriteBatch {
+ public:
+  explicit SpriteBatch(SDL_Renderer* renderer = nullptr);
+
+  void setRenderer(SDL_Renderer* renderer);
+
+  // same arguments and placement rules as SDL_RenderCopyExF
+  void draw(SDL_Texture* texture, const SDL_FRect& destination,
+            const SDL_Rect* clip = nullptr, double angle = 0.0,
+            const SDL_FPoint* centre = nullptr,
+            SDL_RendererFlip flip = SDL_FLIP_NONE,
+            SDL_Color tint = SDL_Color{0xff, 0xff, 0xff, 0xff});
+
+  // mirrors Texture::render, drawing at the clip's (or texture's) size
+  void draw(const Texture& texture, int x, int y,
+            const SDL_Rect* clip = nullptr, double angle = 0.0,
+            const SDL_Point* centre = nullptr,
+            SDL_RendererFlip flip = SDL_FLIP_NONE,
+            SDL_Color tint = SDL_Color{0xff, 0xff, 0xff, 0xff});
+
+  // submits whatever is queued, call before presenting or raw SDL drawing
+  void flush();
+
+  // geometry calls and quads since the last resetStats()
+  int getDrawCalls() const { return m_drawCalls; }
+  int getQuads() const { return m_quads; }
+  void resetStats();
+
+ private:
+  void bind(SDL_Texture* texture);
+
+  SDL_Renderer* m_renderer{nullptr};
+  SDL_Texture* m_texture{nullptr};
+  float m_textureWidth{};
+  float m_textureHeight{};
+
+  std::vector<SDL_Vertex> m_vertices;
+  std::vector<int> m_indices;
+
+  int m_drawCalls{};
+  int m_quads{};
+};
+
+}  // namespace engine
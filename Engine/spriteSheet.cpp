@@ -0,0 +1,341 @@
+#include "spriteSheet.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "assetPack.h"
+
+namespace engine {
+
+namespace {
+constexpr size_t headerSize{8 + 4 * 4};
+constexpr size_t frameSize{7 * 4};
+constexpr size_t animationSize{5 * 4};
+constexpr size_t stepSize{2 * 4};
+
+Uint32 readU32(const Uint8* bytes) {
+  Uint32 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE32(value);
+}
+
+void writeU32(std::ofstream& out, Uint32 value) {
+  for (int i{0}; i < 4; i++) out.put(static_cast<char>(value >> (i * 8)));
+}
+
+// collects the NUL-terminated strings of an index, each written once
+class StringTable {
+ public:
+  Uint32 add(const std::string& text) {
+    Uint32 offset{static_cast<Uint32>(m_bytes.size())};
+    m_bytes.insert(m_bytes.end(), text.begin(), text.end());
+    m_bytes.push_back('\0');
+    return offset;
+  }
+
+  const std::string& bytes() const { return m_bytes; }
+
+ private:
+  std::string m_bytes;
+};
+}  // namespace
+
+constexpr char SpriteSheet::magic[9];
+
+void SpriteSheet::clear() {
+  m_image.clear();
+  m_frames.clear();
+  m_frameNames.clear();
+  m_animations.clear();
+  m_animationNames.clear();
+  m_steps.clear();
+  m_frameIds.clear();
+  m_animationIds.clear();
+}
+
+bool SpriteSheet::addFrame(const std::string& name, const SpriteFrame& frame) {
+  if (!m_frameIds.emplace(name, getFrameCount()).second) {
+    std::cerr << "Sprite sheet: frame " << name << " defined twice\n";
+    return false;
+  }
+  m_frames.push_back(frame);
+  m_frameNames.push_back(name);
+  return true;
+}
+
+bool SpriteSheet::addAnimation(
+    const std::string& name, bool loop,
+    const std::vector<std::pair<std::string, Uint32>>& steps) {
+  if (!m_animationIds.emplace(name, getAnimationCount()).second) {
+    std::cerr << "Sprite sheet: animation " << name << " defined twice\n";
+    return false;
+  }
+
+  SpriteAnimation animation{static_cast<Uint32>(m_steps.size()),
+                            static_cast<Uint32>(steps.size()), 0, loop};
+  for (const auto& step : steps) {
+    int id{findFrame(step.first)};
+    if (id < 0) {
+      std::cerr << "Sprite sheet: animation " << name << " uses unknown frame "
+                << step.first << '\n';
+      return false;
+    }
+    animation.duration += step.second;
+    m_steps.push_back(Step{static_cast<Uint32>(id), animation.duration});
+  }
+
+  m_animations.push_back(animation);
+  m_animationNames.push_back(name);
+  return true;
+}
+
+bool SpriteSheet::parse(const std::string& path) {
+  clear();
+
+  std::ifstream description{path};
+  if (!description) {
+    std::cerr << "Error opening sprite sheet " << path << '\n';
+    return false;
+  }
+
+  std::string line;
+  int number{0};
+  while (std::getline(description, line)) {
+    number++;
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream fields{line};
+    std::string kind;
+    if (!(fields >> kind)) continue;
+
+    bool valid{false};
+    if (kind == "image") {
+      valid = static_cast<bool>(fields >> m_image);
+    } else if (kind == "frame") {
+      std::string name;
+      SpriteFrame frame{};
+      if (fields >> name >> frame.rect.x >> frame.rect.y >> frame.rect.w >>
+          frame.rect.h) {
+        frame.pivot = SDL_Point{frame.rect.w / 2, frame.rect.h / 2};
+        fields >> frame.pivot.x >> frame.pivot.y;
+        valid = addFrame(name, frame);
+      }
+    } else if (kind == "grid") {
+      std::string prefix;
+      SDL_Rect cell{};
+      int columns{};
+      int count{};
+      if (fields >> prefix >> cell.x >> cell.y >> cell.w >> cell.h >>
+              columns >> count &&
+          columns > 0 && count > 0) {
+        SDL_Point pivot{cell.w / 2, cell.h / 2};
+        fields >> pivot.x >> pivot.y;
+
+        valid = true;
+        for (int i{0}; i < count && valid; i++) {
+          SDL_Rect rect{cell.x + (i % columns) * cell.w,
+                        cell.y + (i / columns) * cell.h, cell.w, cell.h};
+          valid = addFrame(prefix + "_" + std::to_string(i),
+                           SpriteFrame{rect, pivot});
+        }
+      }
+    } else if (kind == "animation") {
+      std::string name;
+      std::string mode;
+      if (fields >> name >> mode && (mode == "loop" || mode == "once")) {
+        std::vector<std::pair<std::string, Uint32>> steps;
+        std::string frame;
+        Uint32 duration{};
+        bool paired{true};
+        while (paired && fields >> frame) {
+          paired = static_cast<bool>(fields >> duration);
+          steps.emplace_back(frame, duration);
+        }
+        valid = paired && !steps.empty() &&
+                addAnimation(name, mode == "loop", steps);
+      }
+    }
+
+    if (!valid) {
+      std::cerr << "Bad sprite sheet entry in " << path << ':' << number
+                << ": " << line << '\n';
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SpriteSheet::save(const std::string& path) const {
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  if (!out) {
+    std::cerr << "Error writing " << path << '\n';
+    return false;
+  }
+
+  StringTable strings;
+  strings.add(m_image);
+
+  out.write(magic, sizeof(magic) - 1);
+  writeU32(out, static_cast<Uint32>(m_frames.size()));
+  writeU32(out, static_cast<Uint32>(m_animations.size()));
+  writeU32(out, static_cast<Uint32>(m_steps.size()));
+
+  // names go in frame then animation order, so their offsets are known
+  // before anything refers to them
+  std::vector<Uint32> frameNames;
+  for (const std::string& name : m_frameNames) {
+    frameNames.push_back(strings.add(name));
+  }
+  std::vector<Uint32> animationNames;
+  for (const std::string& name : m_animationNames) {
+    animationNames.push_back(strings.add(name));
+  }
+  writeU32(out, static_cast<Uint32>(strings.bytes().size()));
+
+  for (size_t i{0}; i < m_frames.size(); i++) {
+    const SpriteFrame& frame{m_frames[i]};
+    for (int value : {frame.rect.x, frame.rect.y, frame.rect.w, frame.rect.h,
+                      frame.pivot.x, frame.pivot.y}) {
+      writeU32(out, static_cast<Uint32>(value));
+    }
+    writeU32(out, frameNames[i]);
+  }
+
+  for (size_t i{0}; i < m_animations.size(); i++) {
+    const SpriteAnimation& animation{m_animations[i]};
+    writeU32(out, animation.firstStep);
+    writeU32(out, animation.stepCount);
+    writeU32(out, animation.duration);
+    writeU32(out, animation.loop ? 1 : 0);
+    writeU32(out, animationNames[i]);
+  }
+
+  for (const Step& step : m_steps) {
+    writeU32(out, step.frame);
+    writeU32(out, step.endTime);
+  }
+
+  out.write(strings.bytes().data(), strings.bytes().size());
+  return static_cast<bool>(out);
+}
+
+bool SpriteSheet::loadFile(AssetId asset) {
+  clear();
+
+  std::vector<Uint8> bytes;
+  if (!readAsset(asset, bytes)) return false;
+  const char* path{asset.path()};
+
+  const size_t magicLength{sizeof(magic) - 1};
+  if (bytes.size() < headerSize ||
+      std::memcmp(bytes.data(), magic, magicLength) != 0) {
+    std::cerr << "Error reading " << path << ": not a sprite sheet index\n";
+    return false;
+  }
+
+  const Uint8* cursor{bytes.data() + magicLength};
+  Uint64 frames{readU32(cursor)};
+  Uint64 animations{readU32(cursor + 4)};
+  Uint64 steps{readU32(cursor + 8)};
+  Uint64 stringBytes{readU32(cursor + 12)};
+  cursor += 16;
+
+  Uint64 expected{headerSize + frames * frameSize +
+                  animations * animationSize + steps * stepSize +
+                  stringBytes};
+  const char* strings{reinterpret_cast<const char*>(
+      bytes.data() + (expected - stringBytes))};
+  if (expected != bytes.size() || stringBytes == 0 ||
+      strings[stringBytes - 1] != '\0') {
+    std::cerr << "Error reading " << path << ": truncated sprite sheet\n";
+    return false;
+  }
+
+  // every name is an offset that must land inside the table
+  bool valid{true};
+  auto name = [&](Uint32 offset) {
+    if (offset >= stringBytes) {
+      valid = false;
+      return std::string{};
+    }
+    return std::string{strings + offset};
+  };
+
+  m_image = name(0);
+
+  m_frames.reserve(frames);
+  for (Uint64 i{0}; i < frames; i++, cursor += frameSize) {
+    SpriteFrame frame{};
+    frame.rect = SDL_Rect{static_cast<int>(readU32(cursor)),
+                          static_cast<int>(readU32(cursor + 4)),
+                          static_cast<int>(readU32(cursor + 8)),
+                          static_cast<int>(readU32(cursor + 12))};
+    frame.pivot = SDL_Point{static_cast<int>(readU32(cursor + 16)),
+                            static_cast<int>(readU32(cursor + 20))};
+    std::string frameName{name(readU32(cursor + 24))};
+    m_frameIds.emplace(frameName, static_cast<int>(i));
+    m_frameNames.push_back(std::move(frameName));
+    m_frames.push_back(frame);
+  }
+
+  m_animations.reserve(animations);
+  for (Uint64 i{0}; i < animations; i++, cursor += animationSize) {
+    SpriteAnimation animation{readU32(cursor), readU32(cursor + 4),
+                              readU32(cursor + 8), readU32(cursor + 12) != 0};
+    if (Uint64{animation.firstStep} + animation.stepCount > steps) {
+      valid = false;
+    }
+    std::string animationName{name(readU32(cursor + 16))};
+    m_animationIds.emplace(animationName, static_cast<int>(i));
+    m_animationNames.push_back(std::move(animationName));
+    m_animations.push_back(animation);
+  }
+
+  m_steps.reserve(steps);
+  for (Uint64 i{0}; i < steps; i++, cursor += stepSize) {
+    Step step{readU32(cursor), readU32(cursor + 4)};
+    if (step.frame >= frames) valid = false;
+    m_steps.push_back(step);
+  }
+
+  if (!valid) {
+    std::cerr << "Error reading " << path << ": corrupt sprite sheet\n";
+    clear();
+    return false;
+  }
+  return true;
+}
+
+int SpriteSheet::findFrame(const std::string& name) const {
+  auto found = m_frameIds.find(name);
+  return found == m_frameIds.end() ? -1 : found->second;
+}
+
+int SpriteSheet::findAnimation(const std::string& name) const {
+  auto found = m_animationIds.find(name);
+  return found == m_animationIds.end() ? -1 : found->second;
+}
+
+int SpriteSheet::frameAt(int animation, Uint32 elapsed) const {
+  const SpriteAnimation& playing{m_animations[animation]};
+  if (playing.stepCount == 0) return -1;
+
+  const Step* first{m_steps.data() + playing.firstStep};
+  const Step* last{first + playing.stepCount};
+  if (playing.duration == 0) return static_cast<int>(first->frame);
+
+  Uint32 time{playing.loop ? elapsed % playing.duration
+                           : std::min(elapsed, playing.duration - 1)};
+  const Step* step{std::upper_bound(
+      first, last, time,
+      [](Uint32 value, const Step& candidate) {
+        return value < candidate.endTime;
+      })};
+  return static_cast<int>(step->frame);
+}
+
+}  // namespace engine
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "assetId.h"
+
+namespace engine {
+
+struct SpriteFrame {
+  SDL_Rect rect;
+  // rotation centre and anchor, relative to the frame's top left
+  SDL_Point pivot;
+};
+
+struct SpriteAnimation {
+  Uint32 firstStep;
+  Uint32 stepCount;
+  // milliseconds for one pass
+  Uint32 duration;
+  bool loop;
+};
+
+// frame rectangles and animations of one sprite sheet image. sheets are
+// described in text (see parse()) and compiled by Tools/sheetCompiler into
+// a binary index that loadFile() reads in one go. ids are indices, so
+// everything after a name lookup is constant time. binary layout, all
+// integers little endian:
+//   "SDLSPR01"  frames:u32  animations:u32  steps:u32  stringBytes:u32
+//   frames x { x y w h pivotX pivotY:i32  name:u32 }
+//   animations x { firstStep stepCount duration loop name:u32 }
+//   steps x { frame:u32  endTime:u32 }
+//   stringBytes of NUL-terminated strings, the image path first; names
+//   are offsets into them
+class SpriteSheet {
+ public:
+  SpriteSheet() = default;
+
+  // the text description, one entry per line and '#' starting a comment:
+  //   image <path>
+  //   frame <name> <x> <y> <w> <h> [<pivot x> <pivot y>]
+  //   grid <prefix> <x> <y> <w> <h> <columns> <count> [<pivot x> <pivot y>]
+  //   animation <name> <loop|once> <frame> <ms> [<frame> <ms>]...
+  // grid adds count frames named <prefix>_0 onwards, row by row from
+  // (x, y); pivots default to the frame's centre
+  bool parse(const std::string& path);
+
+  // the binary index
+  bool save(const std::string& path) const;
+  bool loadFile(AssetId asset);
+
+  void clear();
+
+  // -1 when nothing has that name
+  int findFrame(const std::string& name) const;
+  int findAnimation(const std::string& name) const;
+
+  const SpriteFrame& frame(int id) const { return m_frames[id]; }
+  const SpriteAnimation& animation(int id) const { return m_animations[id]; }
+
+  // the frame shown elapsed milliseconds into an animation; looping ones
+  // wrap, others hold their last frame
+  int frameAt(int animation, Uint32 elapsed) const;
+
+  // getters
+  const std::string& getImage() const { return m_image; }
+  int getFrameCount() const { return static_cast<int>(m_frames.size()); }
+  int getAnimationCount() const {
+    return static_cast<int>(m_animations.size());
+  }
+
+  static constexpr char magic[9]{"SDLSPR01"};
+
+ private:
+  struct Step {
+    Uint32 frame;
+    // time since the animation started at which this step ends
+    Uint32 endTime;
+  };
+
+  bool addFrame(const std::string& name, const SpriteFrame& frame);
+  bool addAnimation(const std::string& name, bool loop,
+                    const std::vector<std::pair<std::string, Uint32>>& steps);
+
+  std::string m_image;
+  std::vector<SpriteFrame> m_frames;
+  std::vector<std::string> m_frameNames;
+  std::vector<SpriteAnimation> m_animations;
+  std::vector<std::string> m_animationNames;
+  std::vector<Step> m_steps;
+
+  std::unordered_map<std::string, int> m_frameIds;
+  std::unordered_map<std::string, int> m_animationIds;
+};
+
+}  // namespace engine
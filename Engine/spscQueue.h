@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace engine {
+
+// a fixed size queue between exactly one producer thread and one consumer
+// thread. neither side ever locks or waits: push() fails when the queue is
+// full and pop() when it is empty. each side keeps a stale copy of the
+// other's index and only reloads it when that copy says full (or empty),
+// so the two rarely touch the same cache line. T is copied in and out and
+// should be small and trivially copyable
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "queue capacity must be a power of two");
+
+ public:
+  SpscQueue() = default;
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // producer only
+  bool push(const T& item) {
+    const size_t tail{m_tail.load(std::memory_order_relaxed)};
+    if (tail - m_headCache == Capacity) {
+      m_headCache = m_head.load(std::memory_order_acquire);
+      if (tail - m_headCache == Capacity) return false;
+    }
+    m_items[tail & (Capacity - 1)] = item;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer only
+  bool pop(T& item) {
+    const size_t head{m_head.load(std::memory_order_relaxed)};
+    if (head == m_tailCache) {
+      m_tailCache = m_tail.load(std::memory_order_acquire);
+      if (head == m_tailCache) return false;
+    }
+    item = m_items[head & (Capacity - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+ private:
+  // written by the consumer, with the producer's index as it last saw it
+  alignas(64) std::atomic<size_t> m_head{0};
+  size_t m_tailCache{0};
+
+  // written by the producer, likewise
+  alignas(64) std::atomic<size_t> m_tail{0};
+  size_t m_headCache{0};
+
+  alignas(64) T m_items[Capacity];
+};
+
+}  // namespace engine
@@ -0,0 +1,317 @@
+#include "texture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#include "media.h"
+#include "pixelOps.h"
+#include "textureCache.h"
+
+namespace engine {
+
+Texture::Texture()
+    : m_renderer{nullptr}, m_texture{}, m_width{0}, m_height{0} {}
+
+Texture::~Texture() { deallocate(); }
+
+Texture::Texture(Texture&& other) noexcept
+    : m_renderer{other.m_renderer},
+      m_texture{std::move(other.m_texture)},
+      m_levels{std::move(other.m_levels)},
+      m_width{other.m_width},
+      m_height{other.m_height},
+      m_content{other.m_content},
+      m_streaming{std::move(other.m_streaming)} {
+  other.m_renderer = nullptr;
+  other.m_width = 0;
+  other.m_height = 0;
+  other.m_streaming = Streaming{};
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept {
+  if (this == &other) return *this;
+
+  m_renderer = other.m_renderer;
+  m_texture = std::move(other.m_texture);
+  m_levels = std::move(other.m_levels);
+  m_width = other.m_width;
+  m_height = other.m_height;
+  m_content = other.m_content;
+  m_streaming = std::move(other.m_streaming);
+
+  other.m_renderer = nullptr;
+  other.m_width = 0;
+  other.m_height = 0;
+  other.m_streaming = Streaming{};
+  return *this;
+}
+
+void Texture::deallocate() {
+  m_texture.reset();
+  m_levels.clear();
+  m_width = 0;
+  m_height = 0;
+  m_streaming = Streaming{};
+}
+
+bool Texture::loadFile(SDL_Renderer* renderer, AssetId asset,
+                       bool mipmapped) {
+  deallocate();
+
+  // already keyed and in a format the renderer takes as is
+  SurfaceHandle temp{loadCachedImage(asset, preferredFormat(renderer))};
+  if (!temp) return false;
+
+  return loadSurface(renderer, temp.get(), mipmapped);
+}
+
+bool Texture::loadText(SDL_Renderer* renderer, TTF_Font* font,
+                       const std::string& text, SDL_Color color,
+                       const SDL_Color* background) {
+  if (m_streaming.enabled && renderer == m_renderer) {
+    return streamText(font, text, color, background);
+  }
+
+  deallocate();
+
+  SurfaceHandle temp{renderText(font, text, color, background)};
+  if (!temp) return false;
+
+  return loadSurface(renderer, temp.get());
+}
+
+bool Texture::enableStreaming(SDL_Renderer* renderer, int width, int height) {
+  if (!create(renderer, width, height, SDL_TEXTUREACCESS_STREAMING)) {
+    return false;
+  }
+  setBlendMode(SDL_BLENDMODE_BLEND);
+
+  m_streaming.enabled = true;
+  m_streaming.capacityWidth = width;
+  m_streaming.capacityHeight = height;
+
+  // nothing written yet
+  m_width = 0;
+  m_height = 0;
+  m_content = SDL_Rect{0, 0, 0, 0};
+  return true;
+}
+
+bool Texture::sameText(TTF_Font* font, const std::string& text,
+                       SDL_Color color, const SDL_Color* background) const {
+  const Streaming& last{m_streaming};
+  if (font != last.font || text != last.text) return false;
+  if (std::memcmp(&color, &last.color, sizeof(SDL_Color)) != 0) return false;
+  if ((background != nullptr) != last.shaded) return false;
+  return !background ||
+         std::memcmp(background, &last.background, sizeof(SDL_Color)) == 0;
+}
+
+bool Texture::streamText(TTF_Font* font, const std::string& text,
+                         SDL_Color color, const SDL_Color* background) {
+  if (sameText(font, text, color, background)) return true;
+
+  // ttf refuses empty strings, an empty label just draws nothing
+  SurfaceHandle rendered;
+  if (!text.empty()) {
+    rendered = renderText(font, text, color, background);
+    if (!rendered) return false;
+  }
+  int width{rendered ? rendered->w : 0};
+  int height{rendered ? rendered->h : 0};
+
+  // only reallocate when the text outgrows the texture, and leave headroom
+  if (width > m_streaming.capacityWidth ||
+      height > m_streaming.capacityHeight) {
+    if (!enableStreaming(m_renderer,
+                         std::max(width, m_streaming.capacityWidth * 2),
+                         std::max(height, m_streaming.capacityHeight))) {
+      return false;
+    }
+  }
+
+  if (rendered) {
+    SDL_Rect area{0, 0, width, height};
+    void* pixels{nullptr};
+    int pitch{};
+    if (SDL_LockTexture(m_texture.get(), &area, &pixels, &pitch) != 0) {
+      std::cerr << "Error locking texture: " << SDL_GetError() << '\n';
+      return false;
+    }
+
+    // blitting converts ttf's palettized output straight into the texture
+    SurfaceHandle target{SDL_CreateRGBSurfaceWithFormatFrom(
+        pixels, width, height, 32, pitch, SDL_PIXELFORMAT_ARGB8888)};
+    if (target) {
+      SDL_FillRect(target.get(), NULL, 0);
+      SDL_SetSurfaceBlendMode(rendered.get(), SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(rendered.get(), NULL, target.get(), NULL);
+    }
+    SDL_UnlockTexture(m_texture.get());
+
+    if (!target) {
+      std::cerr << "Error wrapping texture pixels: " << SDL_GetError()
+                << '\n';
+      return false;
+    }
+  }
+
+  m_width = width;
+  m_height = height;
+  m_content = SDL_Rect{0, 0, width, height};
+
+  m_streaming.font = font;
+  m_streaming.text = text;
+  m_streaming.color = color;
+  m_streaming.shaded = background != nullptr;
+  if (background) m_streaming.background = *background;
+  return true;
+}
+
+bool Texture::loadSurface(SDL_Renderer* renderer, SDL_Surface* surface,
+                          bool mipmapped) {
+  deallocate();
+
+  m_renderer = renderer;
+  m_texture.reset(SDL_CreateTextureFromSurface(renderer, surface));
+
+  if (!m_texture) {
+    std::cerr << "Error creating texture: " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  SDL_QueryTexture(m_texture.get(), NULL, NULL, &m_width, &m_height);
+
+  // a missing level only costs quality, the texture itself is fine
+  if (mipmapped) buildLevels(surface);
+  return true;
+}
+
+bool Texture::buildLevels(SDL_Surface* surface) {
+  // the box filter works on any 32-bit layout, others are converted first
+  SurfaceHandle converted;
+  if (surface->format->BytesPerPixel != 4) {
+    converted.reset(
+        SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0));
+    if (!converted) {
+      std::cerr << "Error converting mip source: " << SDL_GetError() << '\n';
+      return false;
+    }
+    surface = converted.get();
+  }
+
+  SDL_BlendMode blending{SDL_BLENDMODE_NONE};
+  SDL_GetTextureBlendMode(m_texture.get(), &blending);
+
+  SurfaceHandle level;
+  SDL_Surface* previous{surface};
+  while (previous->w > 1 || previous->h > 1) {
+    SurfaceHandle next{SDL_CreateRGBSurfaceWithFormat(
+        0, std::max(previous->w / 2, 1), std::max(previous->h / 2, 1), 32,
+        previous->format->format)};
+    if (!next) {
+      std::cerr << "Error creating mip level: " << SDL_GetError() << '\n';
+      return false;
+    }
+
+    SDL_LockSurface(previous);
+    halveBox(previous, next.get());
+    SDL_UnlockSurface(previous);
+
+    TextureHandle texture{SDL_CreateTextureFromSurface(m_renderer, next.get())};
+    if (!texture) {
+      std::cerr << "Error creating mip level: " << SDL_GetError() << '\n';
+      return false;
+    }
+    SDL_SetTextureBlendMode(texture.get(), blending);
+    m_levels.push_back(std::move(texture));
+
+    level = std::move(next);
+    previous = level.get();
+  }
+  return true;
+}
+
+bool Texture::create(SDL_Renderer* renderer, int width, int height,
+                     SDL_TextureAccess access, Uint32 format) {
+  deallocate();
+
+  m_renderer = renderer;
+  m_texture.reset(SDL_CreateTexture(renderer, format, access, width, height));
+
+  if (!m_texture) {
+    std::cerr << "Error creating texture: " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  m_width = width;
+  m_height = height;
+  return true;
+}
+
+void Texture::render(int x, int y, const SDL_Rect* clip, double angle,
+                     const SDL_Point* centre, SDL_RendererFlip flip) {
+  if (!clip) clip = getContent();
+
+  SDL_Rect renderRect{x, y, m_width, m_height};
+  if (clip) {
+    renderRect.w = clip->w;
+    renderRect.h = clip->h;
+  }
+  SDL_RenderCopyEx(m_renderer, m_texture.get(), clip, &renderRect, angle,
+                   centre, flip);
+}
+
+void Texture::render(const SDL_Rect& destination, const SDL_Rect* clip) {
+  if (!clip) clip = getContent();
+
+  SDL_Rect levelClip;
+  SDL_Texture* level{selectLevel(clip, destination.w, destination.h,
+                                 levelClip)};
+  SDL_RenderCopy(m_renderer, level, &levelClip, &destination);
+}
+
+SDL_Texture* Texture::selectLevel(const SDL_Rect* clip, int width,
+                                  int height, SDL_Rect& levelClip) const {
+  levelClip = clip ? *clip : SDL_Rect{0, 0, m_width, m_height};
+
+  // never magnify a level: stop while the next one would still cover the
+  // destination in both directions
+  size_t level{0};
+  while (level < m_levels.size() && (levelClip.w >> (level + 1)) >= width &&
+         (levelClip.h >> (level + 1)) >= height) {
+    level++;
+  }
+  if (level == 0) return m_texture.get();
+
+  levelClip.x >>= level;
+  levelClip.y >>= level;
+  levelClip.w = std::max(levelClip.w >> level, 1);
+  levelClip.h = std::max(levelClip.h >> level, 1);
+  return m_levels[level - 1].get();
+}
+
+void Texture::setColor(Uint8 red, Uint8 green, Uint8 blue) {
+  SDL_SetTextureColorMod(m_texture.get(), red, green, blue);
+  for (const TextureHandle& level : m_levels) {
+    SDL_SetTextureColorMod(level.get(), red, green, blue);
+  }
+}
+
+void Texture::setBlendMode(SDL_BlendMode blending) {
+  SDL_SetTextureBlendMode(m_texture.get(), blending);
+  for (const TextureHandle& level : m_levels) {
+    SDL_SetTextureBlendMode(level.get(), blending);
+  }
+}
+
+void Texture::setAlpha(Uint8 alpha) {
+  SDL_SetTextureAlphaMod(m_texture.get(), alpha);
+  for (const TextureHandle& level : m_levels) {
+    SDL_SetTextureAlphaMod(level.get(), alpha);
+  }
+}
+
+}  // namespace engine
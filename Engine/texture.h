@@ -0,0 +1,113 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <string>
+#include <vector>
+
+#include "assetId.h"
+#include "handles.h"
+
+namespace engine {
+
+// move-only wrapper for an SDL_Texture and the renderer it belongs to
+class Texture {
+ public:
+  Texture();
+  ~Texture();
+
+  Texture(const Texture&) = delete;
+  Texture& operator=(const Texture&) = delete;
+
+  Texture(Texture&& other) noexcept;
+  Texture& operator=(Texture&& other) noexcept;
+
+  void deallocate();
+
+  // loads an image with the cyan background keyed out. mipmapped textures
+  // also keep box-filtered copies at every halving down to 1x1, which
+  // render() picks from when drawing far below full size
+  bool loadFile(SDL_Renderer* renderer, AssetId asset,
+                bool mipmapped = false);
+
+  // turns loadText into an in-place update of one streaming texture with
+  // room for width x height pixels, grown if a string ever needs more
+  bool enableStreaming(SDL_Renderer* renderer, int width, int height);
+
+  // renders solid text, or shaded text when a background is given; once
+  // streaming, an unchanged string costs nothing
+  bool loadText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                SDL_Color color, const SDL_Color* background = nullptr);
+
+  // uploads an already prepared surface
+  bool loadSurface(SDL_Renderer* renderer, SDL_Surface* surface,
+                   bool mipmapped = false);
+
+  // creates a blank texture whose pixels are supplied later
+  bool create(SDL_Renderer* renderer, int width, int height,
+              SDL_TextureAccess access,
+              Uint32 format = SDL_PIXELFORMAT_ARGB8888);
+
+  // draws at (x, y) at the clip's (or texture's) own size
+  void render(int x, int y, const SDL_Rect* clip = nullptr, double angle = 0.0,
+              const SDL_Point* centre = nullptr,
+              SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+  // draws stretched to the destination rectangle, from the smallest mip
+  // level still at least the destination's size
+  void render(const SDL_Rect& destination, const SDL_Rect* clip = nullptr);
+
+  // the level render() would draw clip (or everything) from at width x
+  // height, with levelClip set to the same area within that level
+  SDL_Texture* selectLevel(const SDL_Rect* clip, int width, int height,
+                           SDL_Rect& levelClip) const;
+
+  void setColor(Uint8 red, Uint8 green, Uint8 blue);
+  void setBlendMode(SDL_BlendMode blending);
+  void setAlpha(Uint8 alpha);
+
+  // getters
+  int getWidth() const { return m_width; }
+  int getHeight() const { return m_height; }
+  SDL_Texture* get() const { return m_texture.get(); }
+  SDL_Renderer* getRenderer() const { return m_renderer; }
+  int getLevels() const { return 1 + static_cast<int>(m_levels.size()); }
+  explicit operator bool() const { return m_texture != nullptr; }
+
+  // the part of a streaming texture holding the current text, else null
+  const SDL_Rect* getContent() const {
+    return m_streaming.enabled ? &m_content : nullptr;
+  }
+
+ private:
+  // what loadText last wrote into a streaming texture
+  struct Streaming {
+    bool enabled{false};
+    int capacityWidth{};
+    int capacityHeight{};
+    TTF_Font* font{nullptr};
+    std::string text;
+    SDL_Color color{};
+    SDL_Color background{};
+    bool shaded{false};
+  };
+
+  bool streamText(TTF_Font* font, const std::string& text, SDL_Color color,
+                  const SDL_Color* background);
+  bool sameText(TTF_Font* font, const std::string& text, SDL_Color color,
+                const SDL_Color* background) const;
+
+  bool buildLevels(SDL_Surface* surface);
+
+  SDL_Renderer* m_renderer{nullptr};
+  TextureHandle m_texture;
+  // mip levels 1 and up, each half the size of the one before
+  std::vector<TextureHandle> m_levels;
+  int m_width{};
+  int m_height{};
+  SDL_Rect m_content{};
+  Streaming m_streaming;
+};
+
+}  // namespace engine
@@ -0,0 +1,220 @@
+#include "textureCache.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "assetPack.h"
+#include "embeddedAssets.h"
+#include "media.h"
+
+namespace engine {
+
+namespace {
+constexpr char cacheMagic[9]{"SDLTEX01"};
+constexpr size_t headerSize{8 + 4 * 4 + 8 * 2};
+
+struct CacheHeader {
+  Uint32 width;
+  Uint32 height;
+  Uint32 format;
+  Uint32 pitch;
+  Uint64 sourceSize;
+  Uint64 sourceHash;
+};
+
+bool overridden{false};
+std::string overrideDirectory;
+
+const std::string& cacheDirectory() {
+  if (overridden) return overrideDirectory;
+
+  // created on first use, shared by every program in the repository
+  static const std::string preferences{[] {
+    char* path{SDL_GetPrefPath("personal-sdl-works", "textures")};
+    std::string directory{path ? path : ""};
+    SDL_free(path);
+    return directory;
+  }()};
+  return preferences;
+}
+
+std::string cachePath(AssetId asset, Uint32 format) {
+  char name[40];
+  std::snprintf(name, sizeof(name), "%016llx.%08x.tex",
+                static_cast<unsigned long long>(asset.hash()),
+                static_cast<unsigned>(format));
+  return cacheDirectory() + name;
+}
+
+void putU32(Uint8* out, Uint32 value) {
+  value = SDL_SwapLE32(value);
+  std::memcpy(out, &value, sizeof(value));
+}
+
+void putU64(Uint8* out, Uint64 value) {
+  value = SDL_SwapLE64(value);
+  std::memcpy(out, &value, sizeof(value));
+}
+
+Uint32 getU32(const Uint8* in) {
+  Uint32 value;
+  std::memcpy(&value, in, sizeof(value));
+  return SDL_SwapLE32(value);
+}
+
+Uint64 getU64(const Uint8* in) {
+  Uint64 value;
+  std::memcpy(&value, in, sizeof(value));
+  return SDL_SwapLE64(value);
+}
+
+// the cached pixels when the header matches, read straight into a surface
+SurfaceHandle readCache(const std::string& file, Uint32 format,
+                        Uint64 sourceSize, Uint64 sourceHash) {
+  SDL_RWops* in{SDL_RWFromFile(file.c_str(), "rb")};
+  if (!in) return nullptr;
+
+  Uint8 bytes[headerSize];
+  SurfaceHandle surface;
+  if (SDL_RWread(in, bytes, headerSize, 1) == 1 &&
+      std::memcmp(bytes, cacheMagic, 8) == 0) {
+    CacheHeader header{getU32(bytes + 8),  getU32(bytes + 12),
+                       getU32(bytes + 16), getU32(bytes + 20),
+                       getU64(bytes + 24), getU64(bytes + 32)};
+
+    if (header.format == format && header.sourceSize == sourceSize &&
+        header.sourceHash == sourceHash && header.width > 0 &&
+        header.height > 0) {
+      surface.reset(SDL_CreateRGBSurfaceWithFormat(
+          0, static_cast<int>(header.width), static_cast<int>(header.height),
+          SDL_BITSPERPIXEL(format), format));
+    }
+
+    // rows are read one by one in case the pitches differ
+    if (surface) {
+      size_t row{std::min<size_t>(header.pitch, surface->pitch)};
+      Uint8* pixels{static_cast<Uint8*>(surface->pixels)};
+      for (int y{0}; surface && y < surface->h; y++) {
+        if (SDL_RWread(in, pixels + y * surface->pitch, row, 1) != 1 ||
+            SDL_RWseek(in, header.pitch - row, RW_SEEK_CUR) < 0) {
+          surface.reset();
+        }
+      }
+    }
+  }
+
+  SDL_RWclose(in);
+  return surface;
+}
+
+void writeCache(const std::string& file, SDL_Surface* surface,
+                Uint64 sourceSize, Uint64 sourceHash) {
+  // written aside and renamed so a crash never leaves half a file; each
+  // writer gets its own name so two filling the same entry never share one
+  static std::atomic<unsigned> writes{0};
+  std::string partial{file + '.' + std::to_string(SDL_ThreadID()) + '.' +
+                      std::to_string(writes++) + ".part"};
+  SDL_RWops* out{SDL_RWFromFile(partial.c_str(), "wb")};
+  if (!out) return;
+
+  Uint8 header[headerSize];
+  std::memcpy(header, cacheMagic, 8);
+  putU32(header + 8, static_cast<Uint32>(surface->w));
+  putU32(header + 12, static_cast<Uint32>(surface->h));
+  putU32(header + 16, surface->format->format);
+  putU32(header + 20, static_cast<Uint32>(surface->pitch));
+  putU64(header + 24, sourceSize);
+  putU64(header + 32, sourceHash);
+
+  size_t pixelBytes{static_cast<size_t>(surface->pitch) * surface->h};
+  bool written{SDL_RWwrite(out, header, headerSize, 1) == 1 &&
+               SDL_RWwrite(out, surface->pixels, pixelBytes, 1) == 1};
+  written = SDL_RWclose(out) == 0 && written;
+
+  if (written) {
+    std::remove(file.c_str());
+    written = std::rename(partial.c_str(), file.c_str()) == 0;
+  }
+  if (!written) {
+    std::cerr << "Error writing texture cache " << file << '\n';
+    std::remove(partial.c_str());
+  }
+}
+}  // namespace
+
+void setTextureCacheDirectory(const std::string& directory) {
+  overridden = true;
+  overrideDirectory = directory;
+  if (!overrideDirectory.empty() && overrideDirectory.back() != '/' &&
+      overrideDirectory.back() != '\\') {
+    overrideDirectory += '/';
+  }
+}
+
+Uint32 preferredFormat(SDL_Renderer* renderer) {
+  SDL_RendererInfo info;
+  if (renderer && SDL_GetRendererInfo(renderer, &info) == 0) {
+    for (Uint32 i{0}; i < info.num_texture_formats; i++) {
+      Uint32 format{info.texture_formats[i]};
+      if (SDL_ISPIXELFORMAT_ALPHA(format) &&
+          !SDL_ISPIXELFORMAT_FOURCC(format)) {
+        return format;
+      }
+    }
+  }
+  return SDL_PIXELFORMAT_ARGB8888;
+}
+
+SurfaceHandle loadCachedImage(AssetId asset, Uint32 format) {
+  // the source is read either way: hashing it is far cheaper than decoding
+  std::vector<Uint8> source;
+  if (!readAsset(asset, source)) return nullptr;
+
+  return loadCachedImage(asset, source,
+                         hashBytes(source.data(), source.size()), format);
+}
+
+SurfaceHandle loadCachedImage(AssetId asset, const std::vector<Uint8>& source,
+                              Uint64 hash, Uint32 format) {
+  // compiled-in images are decoded every launch, so a build that embeds
+  // its assets never touches the disk
+  std::string file;
+  if (!findEmbeddedAsset(asset) && !cacheDirectory().empty()) {
+    file = cachePath(asset, format);
+  }
+
+  if (!file.empty()) {
+    SurfaceHandle cached{readCache(file, format, source.size(), hash)};
+    if (cached) return cached;
+  }
+
+  SurfaceHandle decoded{IMG_Load_RW(
+      SDL_RWFromConstMem(source.data(), static_cast<int>(source.size())), 1)};
+  if (!decoded) {
+    std::cerr << "Error loading " << asset.path() << ": " << IMG_GetError()
+              << '\n';
+    return nullptr;
+  }
+
+  SurfaceHandle converted{applyColorKey(std::move(decoded))};
+  if (converted && format != SDL_PIXELFORMAT_ARGB8888) {
+    converted.reset(SDL_ConvertSurfaceFormat(converted.get(), format, 0));
+  }
+  if (!converted) {
+    std::cerr << "Error converting " << asset.path() << ": "
+              << SDL_GetError() << '\n';
+    return nullptr;
+  }
+
+  if (!file.empty()) writeCache(file, converted.get(), source.size(), hash);
+  return converted;
+}
+
+}  // namespace engine
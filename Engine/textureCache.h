@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <vector>
+
+#include "assetId.h"
+#include "handles.h"
+
+namespace engine {
+
+// keeps decoded, colour keyed images on disk in a renderer's own pixel
+// format so later launches skip decoding. each cache file starts with
+//   "SDLTEX01"  width:u32  height:u32  format:u32  pitch:u32
+//   sourceSize:u64  sourceHash:u64
+// followed by the rows; a file whose source no longer matches is rebuilt.
+// files are named after the asset id and format. compiled-in assets are
+// never cached
+
+// the image at path keyed and converted to format, from the cache when it
+// is still valid and otherwise decoded and written back
+SurfaceHandle loadCachedImage(AssetId asset, Uint32 format);
+
+// the same for a source already in memory, with hash from hashBytes()
+SurfaceHandle loadCachedImage(AssetId asset, const std::vector<Uint8>& source,
+                              Uint64 hash, Uint32 format);
+
+// first alpha-capable format the renderer takes without converting
+Uint32 preferredFormat(SDL_Renderer* renderer);
+
+// where cache files go, SDL's per-user preference path by default; an
+// empty directory turns the cache off. set before anything loads
+void setTextureCacheDirectory(const std::string& directory);
+
+}  // namespace engine
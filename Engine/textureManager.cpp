@@ -0,0 +1,163 @@
+#include "textureManager.h"
+
+#include <iostream>
+#include <utility>
+
+namespace engine {
+
+TextureManager::TextureManager(SDL_Renderer* renderer, size_t budget)
+    : m_renderer{renderer}, m_budget{budget} {}
+
+void TextureManager::setRenderer(SDL_Renderer* renderer) {
+  for (Entry& entry : m_entries) {
+    if (entry.texture) evict(entry);
+    entry.failed = false;
+  }
+  m_renderer = renderer;
+}
+
+void TextureManager::setBudget(size_t bytes) {
+  m_budget = bytes;
+  makeRoom(0);
+}
+
+int TextureManager::add(AssetId asset, bool mipmapped) {
+  auto known = m_ids.find(asset.hash());
+  if (known != m_ids.end() &&
+      m_entries[known->second].mipmapped == mipmapped) {
+    return known->second;
+  }
+
+  // the entry owns the path, ids only borrow theirs
+  Entry entry;
+  entry.path = asset.path();
+  entry.mipmapped = mipmapped;
+  m_entries.push_back(std::move(entry));
+
+  int id{static_cast<int>(m_entries.size()) - 1};
+  m_ids.emplace(asset.hash(), id);
+  return id;
+}
+
+TextureManager::Entry* TextureManager::find(int id) {
+  if (id < 0 || id >= static_cast<int>(m_entries.size())) return nullptr;
+  return &m_entries[id];
+}
+
+const TextureManager::Entry* TextureManager::find(int id) const {
+  if (id < 0 || id >= static_cast<int>(m_entries.size())) return nullptr;
+  return &m_entries[id];
+}
+
+bool TextureManager::preload(int id) { return acquire(id) != nullptr; }
+
+Texture* TextureManager::acquire(int id) {
+  Entry* entry{find(id)};
+  if (!entry) return nullptr;
+
+  if (!entry->texture && !load(id, *entry)) return nullptr;
+
+  entry->lastUsed = m_frame;
+  m_recent.splice(m_recent.begin(), m_recent, entry->recent);
+  return &entry->texture;
+}
+
+bool TextureManager::load(int id, Entry& entry) {
+  // a file that failed once is not retried every frame
+  if (entry.failed || !m_renderer) return false;
+
+  if (!entry.texture.loadFile(m_renderer, AssetId{entry.path},
+                               entry.mipmapped)) {
+    entry.failed = true;
+    return false;
+  }
+
+  entry.width = entry.texture.getWidth();
+  entry.height = entry.texture.getHeight();
+  entry.bytes = estimateBytes(entry.texture, entry.mipmapped);
+
+  // the new texture counts once it is in, so it can never evict itself
+  makeRoom(entry.bytes);
+
+  m_residentBytes += entry.bytes;
+  m_recent.push_front(id);
+  entry.recent = m_recent.begin();
+  m_loads++;
+
+  if (m_budget != 0 && m_residentBytes > m_budget) {
+    std::cerr << "TextureManager: " << m_residentBytes
+              << " bytes in use this frame, over the " << m_budget
+              << " byte budget\n";
+  }
+  return true;
+}
+
+void TextureManager::evict(Entry& entry) {
+  entry.texture.deallocate();
+  m_residentBytes -= entry.bytes;
+  m_recent.erase(entry.recent);
+  m_evictions++;
+}
+
+void TextureManager::makeRoom(size_t needed) {
+  if (m_budget == 0) return;
+
+  while (!m_recent.empty() && m_residentBytes + needed > m_budget) {
+    Entry& oldest{m_entries[m_recent.back()]};
+    if (oldest.lastUsed >= m_frame) return;
+    evict(oldest);
+  }
+}
+
+void TextureManager::render(int id, int x, int y, const SDL_Rect* clip,
+                            double angle, const SDL_Point* centre,
+                            SDL_RendererFlip flip) {
+  Texture* texture{acquire(id)};
+  if (texture) texture->render(x, y, clip, angle, centre, flip);
+}
+
+void TextureManager::render(int id, const SDL_Rect& destination,
+                            const SDL_Rect* clip) {
+  Texture* texture{acquire(id)};
+  if (texture) texture->render(destination, clip);
+}
+
+void TextureManager::endFrame() { m_frame++; }
+
+void TextureManager::trim() {
+  while (!m_recent.empty()) {
+    Entry& oldest{m_entries[m_recent.back()]};
+    if (oldest.lastUsed >= m_frame) return;
+    evict(oldest);
+  }
+}
+
+int TextureManager::getWidth(int id) const {
+  const Entry* entry{find(id)};
+  return entry ? entry->width : 0;
+}
+
+int TextureManager::getHeight(int id) const {
+  const Entry* entry{find(id)};
+  return entry ? entry->height : 0;
+}
+
+bool TextureManager::isResident(int id) const {
+  const Entry* entry{find(id)};
+  return entry && entry->texture;
+}
+
+size_t TextureManager::estimateBytes(const Texture& texture, bool mipmapped) {
+  Uint32 format{SDL_PIXELFORMAT_ARGB8888};
+  SDL_QueryTexture(texture.get(), &format, NULL, NULL, NULL);
+
+  size_t bytesPerPixel{SDL_BYTESPERPIXEL(format)};
+  if (bytesPerPixel == 0) bytesPerPixel = 4;
+
+  size_t bytes{static_cast<size_t>(texture.getWidth()) *
+               static_cast<size_t>(texture.getHeight()) * bytesPerPixel};
+  // every level is a quarter of the one before, a third more in total
+  return mipmapped ? bytes + bytes / 3 : bytes;
+}
+
+}  // namespace engine
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <deque>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "assetId.h"
+#include "texture.h"
+
+namespace engine {
+
+// owns textures registered by path and keeps their estimated memory under
+// a budget. textures load on first use; when a load goes over the budget
+// the least recently drawn ones are freed, and a freed texture is loaded
+// again (through the texture cache) the next time it is drawn. textures
+// used in the current frame are never evicted, so anything already queued
+// for drawing stays valid until endFrame()
+class TextureManager {
+ public:
+  explicit TextureManager(SDL_Renderer* renderer = nullptr,
+                          size_t budget = 256 * 1024 * 1024);
+
+  TextureManager(const TextureManager&) = delete;
+  TextureManager& operator=(const TextureManager&) = delete;
+
+  // evicts everything, textures are made again for the new renderer
+  void setRenderer(SDL_Renderer* renderer);
+
+  // bytes of texture memory to stay under, 0 for no limit
+  void setBudget(size_t bytes);
+
+  // registers an image and returns its id; nothing is loaded yet. adding
+  // an asset again returns the id it already has
+  int add(AssetId asset, bool mipmapped = false);
+
+  // loads now, e.g. during a loading screen. false if the file failed
+  bool preload(int id);
+
+  // the resident texture, loaded if needed and marked as used this frame;
+  // null when loading fails. colour, alpha and blend mods set on it are
+  // lost if it is evicted
+  Texture* acquire(int id);
+
+  // Texture::render through acquire()
+  void render(int id, int x, int y, const SDL_Rect* clip = nullptr,
+              double angle = 0.0, const SDL_Point* centre = nullptr,
+              SDL_RendererFlip flip = SDL_FLIP_NONE);
+  void render(int id, const SDL_Rect& destination,
+              const SDL_Rect* clip = nullptr);
+
+  // starts a new frame, after which last frame's textures may be evicted
+  void endFrame();
+
+  // frees every texture not used this frame
+  void trim();
+
+  // getters, sizes are known once a texture has loaded
+  int getWidth(int id) const;
+  int getHeight(int id) const;
+  bool isResident(int id) const;
+  size_t getBudget() const { return m_budget; }
+  size_t getResidentBytes() const { return m_residentBytes; }
+  int getLoads() const { return m_loads; }
+  int getEvictions() const { return m_evictions; }
+
+ private:
+  struct Entry {
+    std::string path;
+    bool mipmapped{false};
+    Texture texture;
+    size_t bytes{0};
+    int width{0};
+    int height{0};
+    Uint64 lastUsed{0};
+    bool failed{false};
+    // position in m_recent while resident
+    std::list<int>::iterator recent;
+  };
+
+  Entry* find(int id);
+  const Entry* find(int id) const;
+
+  bool load(int id, Entry& entry);
+  void evict(Entry& entry);
+  // frees least recently used textures until needed more bytes fit
+  void makeRoom(size_t needed);
+
+  static size_t estimateBytes(const Texture& texture, bool mipmapped);
+
+  SDL_Renderer* m_renderer{nullptr};
+  size_t m_budget{0};
+  size_t m_residentBytes{0};
+  Uint64 m_frame{1};
+
+  // a deque keeps entries in place as more are added
+  std::deque<Entry> m_entries;
+  // resident ids, most recently used first
+  std::list<int> m_recent;
+  // ids by asset, for add()
+  std::unordered_map<Uint64, int, AssetIdHash> m_ids;
+
+  int m_loads{0};
+  int m_evictions{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,287 @@
+#include "tiledImage.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "assetPack.h"
+#include "handles.h"
+
+namespace engine {
+
+namespace {
+constexpr size_t headerSize{8 + 3 * 4};
+constexpr size_t entrySize{2 * 8};
+
+Uint32 readU32(const Uint8* bytes) {
+  Uint32 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE32(value);
+}
+
+Uint64 readU64(const Uint8* bytes) {
+  Uint64 value;
+  std::memcpy(&value, bytes, sizeof(value));
+  return SDL_SwapLE64(value);
+}
+}  // namespace
+
+constexpr char TiledImage::magic[9];
+
+TiledImage::~TiledImage() { close(); }
+
+bool TiledImage::open(SDL_Renderer* renderer, AssetId asset) {
+  close();
+  m_renderer = renderer;
+  m_name = asset.path();
+
+  m_source = openAsset(asset);
+  if (!m_source) {
+    std::cerr << "Error loading " << m_name << ": " << SDL_GetError() << '\n';
+    return false;
+  }
+
+  Sint64 fileSize{SDL_RWsize(m_source)};
+  Uint8 header[headerSize];
+  if (SDL_RWread(m_source, header, headerSize, 1) != 1 ||
+      std::memcmp(header, magic, sizeof(magic) - 1) != 0) {
+    std::cerr << "Error reading " << m_name << ": not a tiled image\n";
+    close();
+    return false;
+  }
+
+  Uint32 width{readU32(header + 8)};
+  Uint32 height{readU32(header + 12)};
+  Uint32 tileSize{readU32(header + 16)};
+  if (width == 0 || height == 0 || tileSize == 0 || width > SDL_MAX_SINT32 ||
+      height > SDL_MAX_SINT32 || tileSize > SDL_MAX_SINT32) {
+    std::cerr << "Error reading " << m_name << ": bad dimensions\n";
+    close();
+    return false;
+  }
+
+  Uint64 columns{(Uint64{width} + tileSize - 1) / tileSize};
+  Uint64 rows{(Uint64{height} + tileSize - 1) / tileSize};
+  Uint64 indexSize{columns * rows * entrySize};
+  if (fileSize < 0 || indexSize > static_cast<Uint64>(fileSize) - headerSize) {
+    std::cerr << "Error reading " << m_name << ": truncated index\n";
+    close();
+    return false;
+  }
+
+  // the whole index in one read, the tiles stay on disk
+  std::vector<Uint8> index(static_cast<size_t>(indexSize));
+  if (SDL_RWread(m_source, index.data(), index.size(), 1) != 1) {
+    std::cerr << "Error reading " << m_name << '\n';
+    close();
+    return false;
+  }
+
+  m_tiles.resize(static_cast<size_t>(columns * rows));
+  for (size_t i{0}; i < m_tiles.size(); i++) {
+    Tile& tile{m_tiles[i]};
+    tile.offset = readU64(index.data() + i * entrySize);
+    tile.size = readU64(index.data() + i * entrySize + 8);
+    if (tile.offset > static_cast<Uint64>(fileSize) ||
+        tile.size > static_cast<Uint64>(fileSize) - tile.offset) {
+      std::cerr << "Error reading " << m_name << ": tile " << i
+                << " lies outside the file\n";
+      close();
+      return false;
+    }
+  }
+
+  m_width = static_cast<int>(width);
+  m_height = static_cast<int>(height);
+  m_tileSize = static_cast<int>(tileSize);
+  m_columns = static_cast<int>(columns);
+  m_rows = static_cast<int>(rows);
+  return true;
+}
+
+void TiledImage::close() {
+  m_tiles.clear();
+  m_resident.clear();
+  if (m_source) SDL_RWclose(m_source);
+  m_source = nullptr;
+  m_width = 0;
+  m_height = 0;
+  m_tileSize = 0;
+  m_columns = 0;
+  m_rows = 0;
+}
+
+void TiledImage::setPrefetch(int ring) { m_prefetch = std::max(ring, 0); }
+
+void TiledImage::setBudget(int tiles) { m_budget = std::max(tiles, 1); }
+
+TiledImage::Range TiledImage::tilesUnder(const SDL_Rect& area) const {
+  const SDL_Rect image{0, 0, m_width, m_height};
+  SDL_Rect visible;
+  if (!SDL_IntersectRect(&area, &image, &visible)) return Range{0, 0, -1, -1};
+
+  return Range{visible.x / m_tileSize, visible.y / m_tileSize,
+               (visible.x + visible.w - 1) / m_tileSize,
+               (visible.y + visible.h - 1) / m_tileSize};
+}
+
+TiledImage::Range TiledImage::grow(const Range& range, int tiles) const {
+  return Range{std::max(range.left - tiles, 0), std::max(range.top - tiles, 0),
+               std::min(range.right + tiles, m_columns - 1),
+               std::min(range.bottom + tiles, m_rows - 1)};
+}
+
+bool TiledImage::loadTile(int index) {
+  Tile& tile{m_tiles[index]};
+  if (tile.failed) return false;
+
+  std::vector<Uint8> bytes(static_cast<size_t>(tile.size));
+  SurfaceHandle surface;
+  if (!bytes.empty() &&
+      SDL_RWseek(m_source, static_cast<Sint64>(tile.offset), RW_SEEK_SET) >=
+          0 &&
+      SDL_RWread(m_source, bytes.data(), bytes.size(), 1) == 1) {
+    surface.reset(IMG_Load_RW(
+        SDL_RWFromConstMem(bytes.data(), static_cast<int>(bytes.size())), 1));
+  }
+
+  if (!surface || !tile.texture.loadSurface(m_renderer, surface.get())) {
+    std::cerr << "Error loading tile " << index << " of " << m_name << '\n';
+    tile.failed = true;
+    return false;
+  }
+
+  m_resident.push_back(index);
+  m_loads++;
+  return true;
+}
+
+void TiledImage::evict(int index) {
+  m_tiles[index].texture.deallocate();
+  m_resident.erase(std::find(m_resident.begin(), m_resident.end(), index));
+  m_evictions++;
+}
+
+void TiledImage::update(const SDL_Rect& viewport) {
+  if (m_tiles.empty()) return;
+
+  const Range visible{tilesUnder(viewport)};
+  if (visible.left > visible.right || visible.top > visible.bottom) return;
+
+  // anything a ring past the prefetch goes first
+  const Range kept{grow(visible, m_prefetch + 1)};
+  for (size_t i{m_resident.size()}; i-- > 0;) {
+    int index{m_resident[i]};
+    if (!kept.contains(index % m_columns, index / m_columns)) evict(index);
+  }
+
+  auto distance = [&visible, this](int index) {
+    int column{index % m_columns};
+    int row{index / m_columns};
+    int dx{std::max({visible.left - column, column - visible.right, 0})};
+    int dy{std::max({visible.top - row, row - visible.bottom, 0})};
+    return std::max(dx, dy);
+  };
+  // room for one more tile, made by dropping the farthest one off screen
+  auto makeRoom = [&distance, this]() {
+    if (static_cast<int>(m_resident.size()) < m_budget) return true;
+    auto farthest = std::max_element(
+        m_resident.begin(), m_resident.end(),
+        [&distance](int a, int b) { return distance(a) < distance(b); });
+    if (farthest == m_resident.end() || distance(*farthest) == 0) {
+      return false;
+    }
+    evict(*farthest);
+    return true;
+  };
+
+  // what is on screen loads as long as the budget allows; a viewport
+  // wider than fitsBudget() allows is drawn with holes rather than
+  // growing past it
+  for (int row{visible.top}; row <= visible.bottom; row++) {
+    for (int column{visible.left}; column <= visible.right; column++) {
+      int index{row * m_columns + column};
+      if (m_tiles[index].texture || m_tiles[index].failed) continue;
+      if (!makeRoom()) return;
+      loadTile(index);
+    }
+  }
+
+  // the ring around it loads a few tiles at a time, nearest first, into
+  // whatever room is left
+  int loads{0};
+  for (int ring{1}; ring <= m_prefetch && loads < m_prefetchLoads; ring++) {
+    const Range inner{grow(visible, ring - 1)};
+    const Range outer{grow(visible, ring)};
+    for (int row{outer.top}; row <= outer.bottom; row++) {
+      for (int column{outer.left}; column <= outer.right; column++) {
+        int index{row * m_columns + column};
+        if (inner.contains(column, row) || m_tiles[index].texture ||
+            m_tiles[index].failed) {
+          continue;
+        }
+        if (loads == m_prefetchLoads ||
+            static_cast<int>(m_resident.size()) >= m_budget) {
+          return;
+        }
+        if (loadTile(index)) loads++;
+      }
+    }
+  }
+}
+
+bool TiledImage::fitsBudget(int width, int height) const {
+  if (m_tileSize == 0) return false;
+
+  // a viewport that is not tile aligned straddles one more tile each way
+  int columns{std::min((width + m_tileSize - 2) / m_tileSize + 1, m_columns)};
+  int rows{std::min((height + m_tileSize - 2) / m_tileSize + 1, m_rows)};
+  return columns * rows <= m_budget;
+}
+
+void TiledImage::render(int x, int y, const SDL_Rect* clip) {
+  SDL_Rect area{clip ? *clip : SDL_Rect{0, 0, m_width, m_height}};
+  render(SDL_Rect{x, y, area.w, area.h}, &area);
+}
+
+void TiledImage::render(const SDL_Rect& destination, const SDL_Rect* clip) {
+  SDL_Rect area{clip ? *clip : SDL_Rect{0, 0, m_width, m_height}};
+  if (area.w <= 0 || area.h <= 0 || m_tiles.empty()) return;
+
+  update(area);
+
+  // each tile's share of the destination, with edges rounded the same way
+  // on both sides so neighbours meet without gaps
+  auto mapX = [&](int x) {
+    return destination.x + static_cast<int>(Sint64{x - area.x} *
+                                            destination.w / area.w);
+  };
+  auto mapY = [&](int y) {
+    return destination.y + static_cast<int>(Sint64{y - area.y} *
+                                            destination.h / area.h);
+  };
+
+  const Range visible{tilesUnder(area)};
+  for (int row{visible.top}; row <= visible.bottom; row++) {
+    for (int column{visible.left}; column <= visible.right; column++) {
+      const Texture& texture{m_tiles[row * m_columns + column].texture};
+      if (!texture) continue;
+
+      SDL_Rect tile{column * m_tileSize, row * m_tileSize, texture.getWidth(),
+                    texture.getHeight()};
+      SDL_Rect part;
+      if (!SDL_IntersectRect(&tile, &area, &part)) continue;
+
+      SDL_Rect source{part.x - tile.x, part.y - tile.y, part.w, part.h};
+      int left{mapX(part.x)};
+      int top{mapY(part.y)};
+      SDL_Rect target{left, top, mapX(part.x + part.w) - left,
+                      mapY(part.y + part.h) - top};
+      SDL_RenderCopy(m_renderer, texture.get(), &source, &target);
+    }
+  }
+}
+
+}  // namespace engine
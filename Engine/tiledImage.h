@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+#include <vector>
+
+#include "assetId.h"
+#include "texture.h"
+
+namespace engine {
+
+// draws images far larger than one texture may be from a tile file made
+// by Tools/imageTiler. only the tiles under the viewport and a prefetch
+// ring around it are decoded and uploaded, tiles further away are freed
+// and no more than the budget's worth are ever resident, whatever the
+// image's size. a viewport needing more tiles than that (check with
+// fitsBudget()) is drawn with the rest missing, so keep views in budget.
+// layout, all integers little endian:
+//   "SDLTIL01"  width:u32  height:u32  tileSize:u32
+//   columns x rows { offset:u64  size:u64 }, row by row
+//   each tile as a PNG, the ones on the right and bottom edges cut short
+class TiledImage {
+ public:
+  TiledImage() = default;
+  ~TiledImage();
+
+  TiledImage(const TiledImage&) = delete;
+  TiledImage& operator=(const TiledImage&) = delete;
+
+  // reads the header and index only, tiles load as they are needed
+  bool open(SDL_Renderer* renderer, AssetId asset);
+  void close();
+
+  // tiles kept around the viewport, and the most loaded at once
+  void setPrefetch(int ring);
+  void setBudget(int tiles);
+
+  // frees the tiles too far from viewport (in image pixels), then loads
+  // the ones under it and a few of the ring around it within the budget.
+  // render() calls it with its clip, calling it ahead with a coming
+  // viewport prefetches
+  void update(const SDL_Rect& viewport);
+
+  // whether every tile under a width x height viewport fits the budget
+  // wherever it is placed
+  bool fitsBudget(int width, int height) const;
+
+  // like Texture::render, clip in image pixels
+  void render(int x, int y, const SDL_Rect* clip = nullptr);
+  void render(const SDL_Rect& destination, const SDL_Rect* clip = nullptr);
+
+  // getters
+  int getWidth() const { return m_width; }
+  int getHeight() const { return m_height; }
+  int getTileSize() const { return m_tileSize; }
+  int getBudget() const { return m_budget; }
+  int getResidentTiles() const { return static_cast<int>(m_resident.size()); }
+  int getLoads() const { return m_loads; }
+  int getEvictions() const { return m_evictions; }
+
+  static constexpr char magic[9]{"SDLTIL01"};
+
+ private:
+  struct Tile {
+    Uint64 offset;
+    Uint64 size;
+    Texture texture;
+    // a tile that failed once is not read again every frame
+    bool failed{false};
+  };
+
+  // the tiles a rectangle of image pixels touches, inclusive
+  struct Range {
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    bool contains(int column, int row) const {
+      return column >= left && column <= right && row >= top &&
+             row <= bottom;
+    }
+  };
+
+  Range tilesUnder(const SDL_Rect& area) const;
+  Range grow(const Range& range, int tiles) const;
+
+  bool loadTile(int index);
+  void evict(int index);
+
+  SDL_Renderer* m_renderer{nullptr};
+  SDL_RWops* m_source{nullptr};
+  std::string m_name;
+
+  int m_width{0};
+  int m_height{0};
+  int m_tileSize{0};
+  int m_columns{0};
+  int m_rows{0};
+  std::vector<Tile> m_tiles;
+  // indices of the tiles holding a texture
+  std::vector<int> m_resident;
+
+  int m_prefetch{1};
+  int m_budget{64};
+  // ring tiles loaded per update(), so prefetching never stalls a frame
+  int m_prefetchLoads{2};
+
+  int m_loads{0};
+  int m_evictions{0};
+};
+
+}  // namespace engine
@@ -0,0 +1,54 @@
+#include "timestep.h"
+
+#include <algorithm>
+
+namespace engine {
+
+FixedTimestep::FixedTimestep(double rate, int maxSteps)
+    : m_rate{rate > 0.0 ? rate : 60.0}, m_maxSteps{std::max(1, maxSteps)} {}
+
+void FixedTimestep::setRate(double rate) {
+  if (rate <= 0.0) return;
+
+  // keep the same fraction of a step banked
+  m_accumulator *= m_rate / rate;
+  m_rate = rate;
+}
+
+void FixedTimestep::reset() {
+  m_lastCounter = 0;
+  m_accumulator = 0.0;
+}
+
+int FixedTimestep::advance() {
+  Uint64 now{SDL_GetPerformanceCounter()};
+
+  // the first call only starts the clock
+  if (m_lastCounter == 0) {
+    m_lastCounter = now;
+    return 0;
+  }
+
+  m_accumulator += static_cast<double>(now - m_lastCounter) /
+                   static_cast<double>(SDL_GetPerformanceFrequency());
+  m_lastCounter = now;
+
+  double step{getStep()};
+  int steps{0};
+  while (m_accumulator >= step && steps < m_maxSteps) {
+    m_accumulator -= step;
+    steps++;
+  }
+
+  // catching up on a long stall would only stall the next frame too
+  if (m_accumulator >= step) {
+    Uint64 behind{static_cast<Uint64>(m_accumulator / step)};
+    m_dropped += behind;
+    m_accumulator -= behind * step;
+  }
+
+  m_updates += steps;
+  return steps;
+}
+
+}  // namespace engine
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+namespace engine {
+
+// decouples simulation from drawing: real time is banked in an accumulator
+// and spent in fixed updates, the remainder says how far between the last
+// two updates a frame should be drawn
+class FixedTimestep {
+ public:
+  explicit FixedTimestep(double rate = 60.0, int maxSteps = 5);
+
+  // updates per second
+  void setRate(double rate);
+
+  // call once per drawn frame, returns how many updates to run now; after
+  // a stall at most maxSteps run and the rest of the backlog is dropped
+  int advance();
+
+  // forgets banked time, e.g. after loading or while paused
+  void reset();
+
+  // getters
+  double getRate() const { return m_rate; }
+  double getStep() const { return 1.0 / m_rate; }
+  // 0 draws the previous update's state, 1 the latest
+  double getAlpha() const { return m_accumulator * m_rate; }
+  Uint64 getUpdates() const { return m_updates; }
+  Uint64 getDroppedUpdates() const { return m_dropped; }
+
+ private:
+  double m_rate{};
+  int m_maxSteps{};
+
+  Uint64 m_lastCounter{0};
+  double m_accumulator{0.0};
+
+  Uint64 m_updates{0};
+  Uint64 m_dropped{0};
+};
+
+// blends a value between two updates by FixedTimestep::getAlpha()
+inline double interpolate(double previous, double current, double alpha) {
+  return previous + (current - previous) * alpha;
+}
+
+}  // namespace engine
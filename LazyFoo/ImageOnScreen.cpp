@@ -3,28 +3,27 @@
 #include <iostream>
 #include <string>
 
+#include "context.h"
+#include "handles.h"
+#include "media.h"
+
 namespace parameters {
 constexpr int scrnWidth{800};
 constexpr int scrnHeight{600};
 }  // namespace parameters
 
 namespace windows {
-// the main SDL Window
-SDL_Window* mainWindow{nullptr};
-
-// the window's main surface
-SDL_Surface* windowSurface{nullptr};
+// the main SDL Window, defined first so it is destroyed last
+engine::Context context;
 
-// the OPENED image file pointer
-SDL_Surface* imageFile{nullptr};
+// the OPENED image file
+engine::SurfaceHandle imageFile;
 }  // namespace windows
 
 // initializes the SDL
 bool initialize();
 // loads an image or other media
 bool loadMedia();
-// closes down the SDL window
-void Close();
 
 int main(int argc, char* argv[]) {
   if (!initialize()) {
@@ -34,8 +33,8 @@ int main(int argc, char* argv[]) {
       std::cout << "\nMEDIA LOAD ERROR";
     } else {
       using namespace windows;
-      SDL_BlitSurface(imageFile, NULL, windowSurface, NULL);
-      SDL_UpdateWindowSurface(mainWindow);
+      SDL_BlitSurface(imageFile.get(), NULL, context.windowSurface(), NULL);
+      SDL_UpdateWindowSurface(context.window());
 
       // Hack to get window to stay up
       SDL_Event e;
@@ -47,67 +46,30 @@ int main(int argc, char* argv[]) {
       }
     }
   }
-  Close();
   return 0;
 }
 
 bool initialize() {
-  bool isSuccess{
-      false};  // bool to determine if window initialization is success
-
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cout << "Error initializing SDL Window: " << SDL_GetError();
-  } else {
-    using namespace windows;
-    using namespace parameters;
-    // attemp to make our window
-    mainWindow = SDL_CreateWindow("Test2", SDL_WINDOWPOS_UNDEFINED,
-                                  SDL_WINDOWPOS_UNDEFINED, scrnWidth,
-                                  scrnHeight, SDL_WINDOW_SHOWN);
+  engine::ContextConfig config;
+  config.title = "Test2";
+  config.width = parameters::scrnWidth;
+  config.height = parameters::scrnHeight;
+  config.createRenderer = false;
 
-    // check for window success
-    if (mainWindow == NULL) {
-      std::cout << "Error Creating Window: " << SDL_GetError();
-    } else {
-      windowSurface = SDL_GetWindowSurface(mainWindow);
-      // EVERYTHING OK, CAN SET SUCCESS
-      isSuccess = true;
-    }
-  }
-  return isSuccess;
+  return windows::context.init(config);
 }
 
 bool loadMedia() {
-  // success indicator flag
-  bool isSuccess{true};
-
   // get the base path
-  std::string basePath {SDL_GetBasePath()};
+  char* basePath{SDL_GetBasePath()};
+  if (basePath) {
+    std::cout << "Opening file at " << basePath << '\n';
+    SDL_free(basePath);
+  }
 
-  std::cout << "Opening file at " << basePath << '\n';
   // try to open the image
-  windows::imageFile = SDL_LoadBMP("..\\/Playground/test.bmp");
+  windows::imageFile = engine::loadBMP("..\\/Playground/test.bmp");
 
   // check if image file was loaded
-  if (windows::imageFile == NULL) {
-    std::cout << "Error opening the image file: " << SDL_GetError();
-    isSuccess = false;
-  }
-
-  return isSuccess;
-}
-
-void Close() {
-  using namespace windows;
-
-  // de allocate surface memory
-  SDL_FreeSurface(imageFile);
-  imageFile = nullptr;
-
-  // destroy the opened window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
-
-  // Close the SDL
-  SDL_Quit();
+  return windows::imageFile != nullptr;
 }
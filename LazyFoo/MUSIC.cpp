@@ -1,92 +1,84 @@
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
-#include <SDL2/SDL_ttf.h>
 
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
 
-namespace audio {
-
-enum effects {
-  soundEff_high,
-  soundEff_low,
-  soundEff_medium,
-  soundEff_scratch,
-  soundEff_max
-};
-
-Mix_Music* mainMusic{nullptr};
-
-std::vector<Mix_Chunk*> soundEffects;
-}  // namespace audio
+#include "assets.h"
+#include "atlas.h"
+#include "audioMixer.h"
+#include "button.h"
+#include "context.h"
+#include "media.h"
+#include "resourceRegistry.h"
+#include "spriteBatch.h"
+#include "spriteSheet.h"
+#include "timestep.h"
 
 bool init();
 bool loadMedia();
-void close();
 
 namespace parameters {
 constexpr int width{800};
 constexpr int height{800};
-constexpr int buttonwidth{300};
-constexpr int buttonHeight{200};
 constexpr int buttonCount{4};
-}  // namespace parameters
 
-enum buttonSprite { mouse_out, mouse_over, mouse_down, mouse_up, mouse_max };
+// simulation steps per second, independent of the display's refresh rate
+constexpr double updateRate{60.0};
+}  // namespace parameters
 
-class Texture {
- public:
-  Texture();
-  ~Texture();
-  void deallocate();
+namespace data {
+// defined first so it is destroyed after everything loaded through it
+engine::Context context;
+engine::SpriteBatch batch;
+// fonts and sounds are loaded once however many places ask for them
+engine::ResourceRegistry resources;
+
+// animation, buttons and static text share one atlas page
+engine::Atlas atlas;
+int animationId{-1};
+int buttonId{-1};
+int textId{-1};
+
+// frame rectangles, compiled from ../sheets/*.sheet
+engine::SpriteSheet walkFrames;
+engine::SpriteSheet buttonFrames;
 
-  void render(int x, int y, SDL_Rect* clip = nullptr, double angle = 0.0,
-              SDL_Point* centre = nullptr,
-              SDL_RendererFlip flip = SDL_FLIP_NONE);
+SDL_Rect sprites[4];
+constexpr int totalFrames{4};
 
-  bool loadFile(std::string path);
+engine::SharedFont mainFont;
 
-  bool loadText(std::string text, SDL_Color& color);
+SDL_Rect buttonSprites[engine::mouse_max];
+int buttonwidth{};
+int buttonHeight{};
+engine::Button buttons[4];
+}  // namespace data
 
-  // getters
-  int getLength() { return m_height; }
-  int getBreadth() { return m_width; }
+namespace audio {
 
- private:
-  bool createTextureFromSurface(SDL_Surface* surf);
-  SDL_Texture* m_texture{nullptr};
-  int m_height{};
-  int m_width{};
+enum effects {
+  soundEff_high,
+  soundEff_low,
+  soundEff_medium,
+  soundEff_scratch,
+  soundEff_max
 };
 
-class Button {
- public:
-  Button();
-  void render();
-  void setPosition(int x, int y);
-  void handleEvent(SDL_Event* e);
+// decoded ahead on its own thread, defined before the mixer reading it
+engine::MusicStream mainMusic;
 
- private:
-  SDL_Point m_position{};
-  buttonSprite m_sprite{};
-};
+// sounds are started from the event loop without taking the audio lock
+engine::AudioMixer mixer;
 
-namespace data {
-SDL_Window* mainWindow{nullptr};
-SDL_Renderer* mainRenderer{nullptr};
-SDL_Rect sprites[4];
-Texture animation;
-constexpr int totalFrames{4};
-
-TTF_Font* mainFont{nullptr};
-Texture text;
+engine::VoiceId musicVoice{0};
+bool musicPaused{false};
 
-SDL_Rect buttonSprites[4];
-Texture button;
-Button buttons[4];
-}  // namespace data
+// mixer sound ids, in the order of the effects enum
+std::vector<int> soundEffects;
+}  // namespace audio
 
 void mouseEventHandler(SDL_Event& event, double& degrees,
                        SDL_RendererFlip& flipType) {
@@ -115,15 +107,18 @@ void mouseEventHandler(SDL_Event& event, double& degrees,
 }
 
 void music() {
-  if (!Mix_PlayingMusic()) {
-    Mix_PlayMusic(audio::mainMusic, -1);
+  using namespace audio;
+  if (!mixer.isPlaying(musicVoice)) {
+    musicVoice = mixer.playStream(mainMusic);
+    musicPaused = false;
     return;
   }
 
-  if (Mix_PausedMusic())
-    Mix_ResumeMusic();
+  musicPaused = !musicPaused;
+  if (musicPaused)
+    mixer.pause(musicVoice);
   else
-    Mix_PauseMusic();
+    mixer.resume(musicVoice);
 }
 
 void keyEventHandle(SDL_Event& event, int& x, int& y) {
@@ -144,28 +139,51 @@ void keyEventHandle(SDL_Event& event, int& x, int& y) {
       x = (x + dP < width) ? x + dP : 0;
       return;
     case SDLK_1:
-      Mix_PlayChannel(-1, soundEffects[soundEff_high], 0);
+      mixer.play(soundEffects[soundEff_high]);
       return;
     case SDLK_2:
-      Mix_PlayChannel(-1, soundEffects[soundEff_medium], 0);
+      mixer.play(soundEffects[soundEff_medium]);
       return;
     case SDLK_3:
-      Mix_PlayChannel(-1, soundEffects[soundEff_low], 0);
+      mixer.play(soundEffects[soundEff_low]);
       return;
     case SDLK_4:
-      Mix_PlayChannel(-1, soundEffects[soundEff_scratch], 0);
+      mixer.play(soundEffects[soundEff_scratch]);
       return;
     case SDLK_9:
       music();
       return;
     case SDLK_0:
-      Mix_HaltMusic();
+      mixer.stop(musicVoice);
+      musicVoice = 0;
+      mainMusic.rewind();
       return;
     default:
       return;
   }
 }
 
+// what the update step moves, kept for the last two updates so frames can
+// be drawn in between
+struct SceneState {
+  double x;
+  double y;
+  double degrees;
+};
+
+// wrapping to the other edge snaps instead of sliding across the screen
+SceneState blend(const SceneState& previous, const SceneState& latest,
+                 double alpha) {
+  SceneState drawn{latest};
+  if (std::abs(latest.x - previous.x) < parameters::width / 2 &&
+      std::abs(latest.y - previous.y) < parameters::height / 2) {
+    drawn.x = engine::interpolate(previous.x, latest.x, alpha);
+    drawn.y = engine::interpolate(previous.y, latest.y, alpha);
+  }
+  drawn.degrees = engine::interpolate(previous.degrees, latest.degrees, alpha);
+  return drawn;
+}
+
 int main(int argc, char* argv[]) {
   if (!init()) {
     std::cerr << "INITIALIZATION FAILURE.\n\n";
@@ -192,9 +210,13 @@ int main(int argc, char* argv[]) {
   int x{parameters::width / 2 - 80};
   int y{parameters::height / 2 - 80};
 
+  // updates run at a fixed rate, frames are drawn between the last two
+  engine::FixedTimestep timestep{parameters::updateRate};
+  SceneState latest{static_cast<double>(x), static_cast<double>(y), degrees};
+  SceneState previous{latest};
+
   while (!quit) {
     using namespace data;
-    SDL_Rect* current{&sprites[frame / 4]};
     while (SDL_PollEvent(&event) != 0) {
       if (event.type == SDL_QUIT) quit = true;
 
@@ -210,233 +232,108 @@ int main(int argc, char* argv[]) {
         buttons[i].handleEvent(&event);
       }
     }
+    audio::mainMusic.update();
+
+    for (int steps{timestep.advance()}; steps > 0; steps--) {
+      previous = latest;
+      latest = SceneState{static_cast<double>(x), static_cast<double>(y),
+                          degrees};
+      frame++;
+      if (frame / 4 >= totalFrames) frame = 0;
+    }
+
+    SDL_Rect* current{&sprites[frame / 4]};
+    SceneState drawn{blend(previous, latest, timestep.getAlpha())};
+    int drawX{static_cast<int>(drawn.x)};
+    int drawY{static_cast<int>(drawn.y)};
 
-    SDL_SetRenderDrawColor(mainRenderer, 0xff, 0xff, 0xff, 0xff);
-    SDL_RenderClear(mainRenderer);
+    SDL_SetRenderDrawColor(context.renderer(), 0xff, 0xff, 0xff, 0xff);
+    SDL_RenderClear(context.renderer());
 
-    animation.render(x, y, current, degrees, nullptr, flipType);
-    text.render(x + 80, y + 80, nullptr, degrees, nullptr, SDL_FLIP_NONE);
+    batch.draw(atlas.texture(animationId), drawX, drawY, current,
+               drawn.degrees, nullptr, flipType);
+    batch.draw(atlas.texture(textId), drawX + 80, drawY + 80,
+               &atlas.region(textId).rect, drawn.degrees, nullptr,
+               SDL_FLIP_NONE);
 
     for (int i{0}; i < parameters::buttonCount; i++) {
-      buttons[i].render();
+      buttons[i].render(batch);
     }
 
-    SDL_RenderPresent(mainRenderer);
-    frame++;
-    if (frame / 4 >= totalFrames) frame = 0;
+    batch.flush();
+    SDL_RenderPresent(context.renderer());
   }
 
-  close();
   return 0;
 }
 
-Texture::Texture() : m_texture{nullptr}, m_height{0}, m_width{0} {}
-Texture::~Texture() { deallocate(); }
-
-void Texture::deallocate() {
-  if (m_texture) {
-    SDL_DestroyTexture(m_texture);
-    m_texture = nullptr;
-  }
-}
-
-bool Texture::loadFile(std::string path) {
-  deallocate();
-
-  SDL_Surface* temp{IMG_Load(path.c_str())};
-
-  if (!temp) {
-    std::cerr << "Error loading temp surface: " << IMG_GetError() << '\n';
-    return false;
-  }
 
-  SDL_SetColorKey(temp, SDL_TRUE, SDL_MapRGB(temp->format, 0x00, 0xff, 0xff));
-
-  return createTextureFromSurface(temp);
-}
-
-void Texture::render(int x, int y, SDL_Rect* clip, double angle,
-                     SDL_Point* centre, SDL_RendererFlip flip) {
-  SDL_Rect renderRect{x, y, m_width, m_height};
-  if (clip) {
-    renderRect.w = clip->w;
-    renderRect.h = clip->h;
-  }
-  SDL_RenderCopyEx(data::mainRenderer, m_texture, clip, &renderRect, angle,
-                   centre, flip);
-}
-
-bool Texture::loadText(std::string text, SDL_Color& color) {
-  deallocate();
-  SDL_Color textCol{0xff, 0xff, 0xff};
-  SDL_Surface* temp{
-      TTF_RenderUTF8_Shaded(data::mainFont, text.c_str(), color, textCol)};
-
-  if (!temp) {
-    std::cerr << "Error creating text: " << TTF_GetError() << '\n';
-    return false;
-  }
-
-  return {createTextureFromSurface(temp)};
-}
-
-// private function
-bool Texture::createTextureFromSurface(SDL_Surface* temp) {
-  m_texture = SDL_CreateTextureFromSurface(data::mainRenderer, temp);
-
-  SDL_FreeSurface(temp);
-  temp = nullptr;
-
-  if (!m_texture) {
-    std::cerr << "Error loading texture: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  SDL_QueryTexture(m_texture, NULL, NULL, &m_width, &m_height);
-  return true;
-}
-
-Button::Button() {
-  m_position.x = 0;
-  m_position.y = 0;
-}
-
-void Button::setPosition(int x, int y) {
-  m_position.x = x;
-  m_position.y = y;
-}
-
-void Button::render() {
-  data::button.render(m_position.x, m_position.y,
-                      &data::buttonSprites[m_sprite]);
-}
-
-void Button::handleEvent(SDL_Event* event) {
-  int x{}, y{};
-  SDL_GetMouseState(&x, &y);
-
-  if (x < m_position.x || x > m_position.x + parameters::buttonwidth ||
-      y < m_position.y || y > m_position.y + parameters::buttonHeight) {
-    m_sprite = mouse_out;
-    return;
-  }
-
-  switch (event->type) {
-    case SDL_MOUSEBUTTONDOWN:
-      m_sprite = mouse_down;
-      return;
-    case SDL_MOUSEBUTTONUP:
-      m_sprite = mouse_up;
-      return;
-    case SDL_MOUSEMOTION:
-      m_sprite = mouse_over;
-      return;
-  }
+bool init() {
+  engine::ContextConfig config;
+  config.title = "part_anim";
+  config.width = parameters::width;
+  config.height = parameters::height;
+  config.subsystems =
+      engine::subsystem_image | engine::subsystem_ttf | engine::subsystem_mixer;
+  config.rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+
+  return data::context.init(config);
 }
 
-bool init() {
+bool loadMedia() {
   using namespace data;
+  using namespace parameters;
 
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-    std::cerr << "Error initializing sdl: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-    std::cerr << "Error initializing img: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-    std::cerr << "Error initializing mixer: " << Mix_GetError() << '\n';
-    return false;
-  }
-
-  if (TTF_Init() == -1) {
-    std::cerr << "TTF Init Failure: " << TTF_GetError() << '\n';
-    return false;
-  }
-
-  mainWindow = SDL_CreateWindow("part_anim", SDL_WINDOWPOS_UNDEFINED,
-                                SDL_WINDOWPOS_UNDEFINED, parameters::width,
-                                parameters::height, SDL_WINDOW_SHOWN);
+  SDL_Renderer* renderer{context.renderer()};
+  batch.setRenderer(renderer);
 
-  if (mainWindow == NULL) {
-    std::cerr << "SDL Window Creation Failure: " << SDL_GetError() << '\n';
+  if (!walkFrames.loadFile(assets::animationSheet) ||
+      !buttonFrames.loadFile(assets::buttonSheet)) {
     return false;
   }
 
-  mainRenderer = SDL_CreateRenderer(
-      mainWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  animationId = atlas.addFile(assets::animation);
+  if (animationId < 0) return false;
 
-  if (mainRenderer == NULL) {
-    std::cerr << "SDL Renderer Creation Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
+  // load font
+  {
+    mainFont = resources.loadFont(assets::font, 28);
+    if (!mainFont) return false;
 
-  if (SDL_SetRenderDrawColor(mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF) != 0) {
-    std::cerr << "SDL RENDERER DRAW ERROR: " << SDL_GetError() << '\n';
-    return false;
+    SDL_Color textCol{0, 0, 0};
+    SDL_Color textBackground{0xff, 0xff, 0xff};
+    textId = atlas.addSurface(
+        "text", engine::renderText(mainFont.get(), "im stickman :D", textCol,
+                                   &textBackground));
+    if (textId < 0) return false;
   }
 
-  return true;
-}
+  buttonId = atlas.addFile(assets::button);
+  if (buttonId < 0) return false;
 
-bool loadMedia() {
-  using namespace data;
-  using namespace parameters;
+  // one upload for everything above, clips are then page relative
+  if (!atlas.build(renderer)) return false;
 
-  // load animation
-  {
-    if (!animation.loadFile("../img/6_animation.png")) return false;
-
-    sprites[0].x = 0;
-    sprites[0].y = 0;
-    sprites[0].w = 64;
-    sprites[0].h = 205;
-
-    sprites[1].x = 64;
-    sprites[1].y = 0;
-    sprites[1].w = 64;
-    sprites[1].h = 205;
-
-    sprites[2].x = 128;
-    sprites[2].y = 0;
-    sprites[2].w = 64;
-    sprites[2].h = 205;
-
-    sprites[3].x = 192;
-    sprites[3].y = 0;
-    sprites[3].w = 64;
-    sprites[3].h = 205;
-  }
-
-  // load font
-  {
-    mainFont = TTF_OpenFont(
-        "C:/Users/HP/AppData/Local/Microsoft/Windows/Fonts/"
-        "mononoki-Regular.ttf",
-        28);
-    if (!mainFont) {
-      std::cerr << "Error opening font: " << TTF_GetError() << '\n';
-      return -1;
-    }
-
-    SDL_Color textCol{0, 0, 0};
-    if (!text.loadText("im stickman :D", textCol)) {
-      return -1;
-    };
+  for (int i{0}; i < totalFrames; i++) {
+    int id{walkFrames.findFrame("walk_" + std::to_string(i))};
+    if (id < 0) return false;
+    sprites[i] = atlas.clip(animationId, walkFrames.frame(id).rect);
   }
 
   // load buttons
   {
-    if (!button.loadFile("../img/button.png")) return false;
+    const char* states[engine::mouse_max]{"out", "over", "down", "up"};
+    for (int i = 0; i < engine::mouse_max; ++i) {
+      int id{buttonFrames.findFrame(states[i])};
+      if (id < 0) return false;
+      buttonSprites[i] = atlas.clip(buttonId, buttonFrames.frame(id).rect);
+    }
+    buttonwidth = buttonSprites[engine::mouse_out].w;
+    buttonHeight = buttonSprites[engine::mouse_out].h;
 
     for (int i = 0; i < buttonCount; ++i) {
-      buttonSprites[i].x = 0;
-      buttonSprites[i].y = i * 200;
-      buttonSprites[i].w = buttonwidth;
-      buttonSprites[i].h = buttonHeight;
+      buttons[i].setSprites(&atlas.texture(buttonId), buttonSprites);
+      buttons[i].setSize(buttonwidth, buttonHeight);
     }
 
     // Set buttons in corners
@@ -450,53 +347,19 @@ bool loadMedia() {
   {
     using namespace audio;
 
-    mainMusic = Mix_LoadMUS("../sound/beat.wav");
+    if (!mixer.open()) return false;
 
-    std::string prefix{"../sound/"};
+    if (!mainMusic.open(assets::beat, mixer.getFrequency())) return false;
 
-    std::vector<std::string> effects{"high.wav", "low.wav", "medium.wav",
-                                     "scratch.wav"};
+    // in the order of the effects enum
+    const engine::AssetId effects[soundEff_max]{assets::high, assets::low,
+                                                assets::medium,
+                                                assets::scratch};
 
-    for (size_t i{0}; i < effects.size(); i++) {
-      std::string temp{prefix + effects[i]};
-      soundEffects.push_back(Mix_LoadWAV(temp.c_str()));
-      if (!soundEffects[i]) {
-        std::cerr << "Failed to load " << temp << "\n"
-                  << Mix_GetError() << '\n';
-        return false;
-      }
+    for (const engine::AssetId& effect : effects) {
+      soundEffects.push_back(mixer.addSound(resources.loadChunk(effect)));
+      if (soundEffects.back() < 0) return false;
     }
   }
   return true;
 }
-
-void close() {
-  using namespace data;
-  using namespace audio;
-
-  // close music
-  Mix_FreeMusic(mainMusic);
-  for (auto i : soundEffects) {
-    Mix_FreeChunk(i);
-    i = nullptr;
-  }
-
-  // delete texture
-  animation.deallocate();
-  text.deallocate();
-
-  // close font
-  TTF_CloseFont(mainFont);
-
-  // delete renderer
-  SDL_DestroyRenderer(mainRenderer);
-  mainRenderer = nullptr;
-
-  // delete window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
-
-  TTF_Quit();
-  IMG_Quit();
-  SDL_Quit();
-}
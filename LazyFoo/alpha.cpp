@@ -1,12 +1,17 @@
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 
 #include <iostream>
+#include <memory>
 #include <string>
 
+#include "assetLoader.h"
+#include "assets.h"
+#include "context.h"
+#include "lazyTexture.h"
+#include "renderQueue.h"
+
 bool init();
 bool loadMedia();
-void close();
 void setRGB(Uint8& r, Uint8& g, Uint8& b, Uint8& a, SDL_Event& event);
 
 namespace parameters {
@@ -21,32 +26,16 @@ Uint8 b = 255;
 Uint8 a = 255;
 }  // namespace colors
 
-class Texture {
- public:
-  Texture();
-  ~Texture();
-  bool load(std::string);
-  void render(int x, int y, SDL_Rect* clip = NULL);
-  void deallocate();
-  void setColor(Uint8 red, Uint8 green, Uint8 blue);
-  void setBlendMode(SDL_BlendMode);
-  void setAlpha(Uint8 alpha);
-
-  // getters
-  int getHeight() { return m_height; }
-  int getWidth() { return m_width; }
-
- private:
-  SDL_Texture* m_texture{nullptr};
-  int m_height{};
-  int m_width{};
-};
-
 namespace data {
-SDL_Window* mainWindow{nullptr};
-SDL_Renderer* mainRenderer{nullptr};
-Texture man;
-Texture bg;
+// defined first so it is destroyed after the textures
+engine::Context context;
+engine::RenderQueue queue;
+
+// the images decode in the background, the scene draws from the first
+// frame and they appear as they arrive
+engine::AssetLoader loader;
+engine::LazyTexture man;
+engine::LazyTexture bg;
 }  // namespace data
 
 int main(int argc, char* argv[]) {
@@ -75,84 +64,25 @@ int main(int argc, char* argv[]) {
       else if (event.type == SDL_KEYDOWN) {
         setRGB(r, g, b, a, event);
       }
-
-      // clrscrn
-      SDL_SetRenderDrawColor(mainRenderer, 0x00, 0x00, 0xff, 0x00);
-      SDL_RenderClear(mainRenderer);
-
-      bg.render(0, 0);
-      man.render(40, 390 - man.getHeight());
-
-      bg.setColor(r, g, b);
-      man.setColor(r, g, b);
-      man.setAlpha(a);
-
-      SDL_RenderPresent(mainRenderer);
     }
-  }
-  close();
-  return 0;
-}
-
-Texture::Texture() : m_texture{}, m_height{}, m_width{} {}
 
-Texture::~Texture() { deallocate(); }
+    // swaps in whatever finished loading since the last frame
+    loader.update();
 
-bool Texture::load(std::string path) {
-  deallocate();
+    // clrscrn
+    SDL_SetRenderDrawColor(context.renderer(), 0x00, 0x00, 0xff, 0x00);
+    SDL_RenderClear(context.renderer());
 
-  SDL_Surface* temp{IMG_Load(path.c_str())};
+    // the colour and alpha travel with each draw instead of being set on
+    // the textures, the queue only changes them when they differ
+    bg.render(queue, 0, 0, 0, nullptr, SDL_Color{r, g, b, 0xff});
+    man.render(queue, 0, 40, 390 - man.getHeight(), nullptr,
+               SDL_Color{r, g, b, a});
+    queue.flush();
 
-  if (!temp) {
-    std::cerr << "Error opening file: " << IMG_GetError() << '\n';
-    return false;
+    SDL_RenderPresent(context.renderer());
   }
-
-  SDL_SetColorKey(temp, SDL_TRUE, SDL_MapRGB(temp->format, 0x00, 0xff, 0xff));
-
-  m_texture = SDL_CreateTextureFromSurface(data::mainRenderer, temp);
-
-  if (!m_texture) {
-    std::cerr << "Error creating texture: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  // fill in the information
-  SDL_QueryTexture(m_texture, NULL, NULL, &m_width, &m_height);
-
-  // free the temporary surface
-  SDL_FreeSurface(temp);
-
-  return true;
-}
-
-void Texture::render(int x, int y, SDL_Rect* clip) {
-  SDL_Rect renderRect{x, y, m_width, m_height};
-  if (clip) {
-    renderRect.w = clip->w * 2;
-    renderRect.h = clip->h * 2;
-  }
-  SDL_RenderCopy(data::mainRenderer, m_texture, clip, &renderRect);
-}
-
-void Texture::deallocate() {
-  if (!m_texture) return;
-  SDL_DestroyTexture(m_texture);
-  m_texture = nullptr;
-  m_height = 0;
-  m_width = 0;
-}
-
-void Texture::setColor(Uint8 red, Uint8 green, Uint8 blue) {
-  SDL_SetTextureColorMod(m_texture, red, green, blue);
-}
-
-void Texture::setBlendMode(SDL_BlendMode blendmode) {
-  SDL_SetTextureBlendMode(m_texture, blendmode);
-}
-
-void Texture::setAlpha(Uint8 alpha) {
-  SDL_SetTextureAlphaMod(m_texture, alpha);
+  return 0;
 }
 
 void setRGB(Uint8& r, Uint8& g, Uint8& b, Uint8& a, SDL_Event& event) {
@@ -200,63 +130,32 @@ void setRGB(Uint8& r, Uint8& g, Uint8& b, Uint8& a, SDL_Event& event) {
 }
 
 bool init() {
-  data::mainWindow = SDL_CreateWindow(
-      "Clip Rendering", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-      parameters::width, parameters::height, SDL_WINDOW_SHOWN);
-
-  if (!data::mainWindow) {
-    std::cerr << "Error creating window: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  data::mainRenderer =
-      SDL_CreateRenderer(data::mainWindow, -1, SDL_RENDERER_ACCELERATED);
-
-  if (!data::mainRenderer) {
-    std::cerr << "Renderer creation error: " << SDL_GetError();
-    return false;
-  }
-
-  if (SDL_SetRenderDrawColor(data::mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF) != 0) {
-    std::cerr << "SDL RENDERER DRAW ERROR: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  return true;
+  engine::ContextConfig config;
+  config.title = "Clip Rendering";
+  config.width = parameters::width;
+  config.height = parameters::height;
+  config.subsystems = engine::subsystem_image;
+  // drawn every frame while loading, so paced by the display
+  config.rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+
+  return data::context.init(config);
 }
 
+// only queues the loads: a missing image is reported by the loader and
+// leaves its placeholder on screen instead of ending the program
 bool loadMedia() {
-  if (!data::man.load("../img/5_man.png")) {
-    std::cerr << "IMG LOAD ERROR\n";
-    return false;
-  }
-
-  data::man.setBlendMode(SDL_BLENDMODE_BLEND);
-
-  if (!data::bg.load("../img/5_bg.png")) {
-    std::cerr << "IMG LOAD ERROR\n";
-    return false;
-  }
-
-  return true;
-}
-
-void close() {
   using namespace data;
 
-  // free textures
-  man.deallocate();
-  bg.deallocate();
+  SDL_Renderer* renderer{context.renderer()};
+  queue.setRenderer(renderer);
 
-  // destroy renderer
-  SDL_DestroyRenderer(mainRenderer);
-  mainRenderer = nullptr;
+  loader.setPlaceholder(
+      std::make_shared<engine::Texture>(engine::makePlaceholder(renderer)));
 
-  // destroy window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
+  // the background is known to fill the window, the man shows up when ready
+  bg = loader.requestTexture(renderer, assets::background, false,
+                             parameters::width, parameters::height);
+  man = loader.requestTexture(renderer, assets::man);
 
-  // quit sdl
-  IMG_Quit();
-  SDL_Quit();
+  return true;
 }
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "assetId.h"
+#include "media.h"
+
+// every file the lessons load, hashed at compile time. paths are relative
+// to LazyFoo/ like the programs' working directory
+namespace assets {
+using namespace engine::literals;
+
+constexpr engine::AssetId font{engine::defaultFontPath};
+
+constexpr engine::AssetId keysDefault{"../img/3default.bmp"_asset};
+constexpr engine::AssetId keysUp{"../img/3up.bmp"_asset};
+constexpr engine::AssetId keysDown{"../img/3down.bmp"_asset};
+constexpr engine::AssetId keysRight{"../img/3right.bmp"_asset};
+constexpr engine::AssetId keysLeft{"../img/3left.bmp"_asset};
+constexpr engine::AssetId defaultImage{"../img/4default.png"_asset};
+constexpr engine::AssetId background{"../img/5_bg.png"_asset};
+constexpr engine::AssetId man{"../img/5_man.png"_asset};
+constexpr engine::AssetId animation{"../img/6_animation.png"_asset};
+constexpr engine::AssetId button{"../img/button.png"_asset};
+constexpr engine::AssetId sprites{"../img/sprites.png"_asset};
+constexpr engine::AssetId borderTiles{"../img/t_border.tiles"_asset};
+
+constexpr engine::AssetId animationSheet{"../sheets/6_animation.sprites"_asset};
+constexpr engine::AssetId buttonSheet{"../sheets/button.sprites"_asset};
+constexpr engine::AssetId spritesSheet{"../sheets/sprites.sprites"_asset};
+
+constexpr engine::AssetId beat{"../sound/beat.wav"_asset};
+constexpr engine::AssetId high{"../sound/high.wav"_asset};
+constexpr engine::AssetId low{"../sound/low.wav"_asset};
+constexpr engine::AssetId medium{"../sound/medium.wav"_asset};
+constexpr engine::AssetId scratch{"../sound/scratch.wav"_asset};
+
+constexpr engine::AssetId all[]{
+    font,
+    keysDefault,
+    keysUp,
+    keysDown,
+    keysRight,
+    keysLeft,
+    defaultImage,
+    background,
+    man,
+    animation,
+    button,
+    sprites,
+    borderTiles,
+    animationSheet,
+    buttonSheet,
+    spritesSheet,
+    beat,
+    high,
+    low,
+    medium,
+    scratch};
+
+// a new asset whose path hashes like an existing one stops the build
+static_assert(engine::uniqueIds(all), "two lesson assets share an asset id");
+}  // namespace assets
@@ -1,38 +1,45 @@
-#include <SDL2\SDL.h>
+#include <SDL2/SDL.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
+#include "assets.h"
+#include "context.h"
+#include "tiledImage.h"
+
 namespace parameters {
 constexpr int scrnWidth{600};
 constexpr int scrnHeight{800};
 }  // namespace parameters
 
 namespace windows {
-// the main SDL Window
-SDL_Window* mainWindow{nullptr};
+// the main SDL Window, defined first so it is destroyed last
+engine::Context context;
 
-// the window's main surface
-SDL_Surface* windowSurface{nullptr};
+// streamed a tile at a time, so the image may be any size
+engine::TiledImage image;
 
-// the OPENED image file pointer
-SDL_Surface* imageFile{nullptr};
+// the part of the image stretched over the window, in image pixels
+SDL_Rect view;
 }  // namespace windows
 
 // initializes the SDL
 bool initialize();
 // loads an image or other media
-bool loadMedia();
-// closes down the SDL window
-void Close();
-// loads an image surface
-SDL_Surface* loadSurface(std::string filename);
+bool loadMedia(engine::AssetId asset);
+// arrows pan, the wheel zooms around the centre
+void moveView(const SDL_Event& event);
 
+// an optional argument names another tile file, e.g. a map made with
+// imageTiler
 int main(int argc, char* argv[]) {
   if (!initialize()) {
     std::cout << "\nINITIALIZATION ERROR";
   } else {
-    if (!loadMedia()) {
+    engine::AssetId asset{argc > 1 ? engine::AssetId{argv[1]}
+                                   : assets::borderTiles};
+    if (!loadMedia(asset)) {
       std::cout << "\nMEDIA LOAD ERROR";
     } else {
       using namespace windows;
@@ -40,92 +47,92 @@ int main(int argc, char* argv[]) {
       SDL_Rect stretchRectangle{0, 0, parameters::scrnWidth,
                                 parameters::scrnHeight};
 
-      // stretch the image
-      SDL_BlitScaled(imageFile, NULL, windowSurface, &stretchRectangle);
-      SDL_UpdateWindowSurface(mainWindow);
-
-      // Hack to get window to stay up
       SDL_Event e;
       bool quit = false;
       while (!quit) {
         while (SDL_PollEvent(&e)) {
           if (e.type == SDL_QUIT) quit = true;
+          moveView(e);
         }
+
+        // only the tiles under the view (and a ring around it) are loaded
+        SDL_SetRenderDrawColor(context.renderer(), 0x00, 0x00, 0x00, 0xff);
+        SDL_RenderClear(context.renderer());
+        image.render(stretchRectangle, &view);
+        SDL_RenderPresent(context.renderer());
       }
     }
   }
-  Close();
   return 0;
 }
 
-bool initialize() {
-  bool isSuccess{
-      false};  // bool to determine if window initialization is success
-
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cout << "Error initializing SDL Window: " << SDL_GetError();
-  } else {
-    using namespace windows;
-    using namespace parameters;
-    // attemp to make our window
-    mainWindow = SDL_CreateWindow("Test2", SDL_WINDOWPOS_UNDEFINED,
-                                  SDL_WINDOWPOS_UNDEFINED, scrnWidth, scrnHeight, 0);
-
-    // check for window success
-    if (mainWindow == NULL) {
-      std::cout << "Error Creating Window: " << SDL_GetError();
+void moveView(const SDL_Event& event) {
+  using windows::image;
+  using windows::view;
+
+  if (event.type == SDL_KEYDOWN) {
+    int stepX{std::max(view.w / 10, 1)};
+    int stepY{std::max(view.h / 10, 1)};
+    switch (event.key.keysym.sym) {
+      case SDLK_LEFT:
+        view.x -= stepX;
+        break;
+      case SDLK_RIGHT:
+        view.x += stepX;
+        break;
+      case SDLK_UP:
+        view.y -= stepY;
+        break;
+      case SDLK_DOWN:
+        view.y += stepY;
+        break;
+    }
+  } else if (event.type == SDL_MOUSEWHEEL && event.wheel.y != 0) {
+    int centreX{view.x + view.w / 2};
+    int centreY{view.y + view.h / 2};
+    if (event.wheel.y > 0) {
+      view.w = std::max(view.w / 2, 1);
+      view.h = std::max(view.h / 2, 1);
     } else {
-      windowSurface = SDL_GetWindowSurface(mainWindow);
-      // EVERYTHING OK, CAN SET SUCCESS
-      isSuccess = true;
+      // no further out than the tile budget can cover
+      int width{std::min(view.w * 2, image.getWidth())};
+      int height{std::min(view.h * 2, image.getHeight())};
+      if (image.fitsBudget(width, height)) {
+        view.w = width;
+        view.h = height;
+      }
     }
-  }
-  return isSuccess;
-}
-
-bool loadMedia() {
-  // success indicator flag
-  bool isSuccess{true};
-
-  windows::imageFile = loadSurface("../img/t_border.bmp");
-
-  if (windows::imageFile == NULL) {
-    std::cout << '\n' << SDL_GetError();
-    isSuccess = false;
+    view.x = centreX - view.w / 2;
+    view.y = centreY - view.h / 2;
   }
 
-  return isSuccess;
+  view.x = std::max(0, std::min(view.x, image.getWidth() - view.w));
+  view.y = std::max(0, std::min(view.y, image.getHeight() - view.h));
 }
 
-void Close() {
-  using namespace windows;
-
-  // de allocate surface memory
-  SDL_FreeSurface(imageFile);
-  imageFile = nullptr;
-
-  // destroy the opened window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
-
-  // Close the SDL
-  SDL_Quit();
+bool initialize() {
+  engine::ContextConfig config;
+  config.title = "Test2";
+  config.width = parameters::scrnWidth;
+  config.height = parameters::scrnHeight;
+  config.windowFlags = 0;
+  config.subsystems = engine::subsystem_image;
+  config.rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+
+  return windows::context.init(config);
 }
 
-SDL_Surface* loadSurface(std::string filename) {
-  SDL_Surface* optimizedSurface{nullptr};
+bool loadMedia(engine::AssetId asset) {
+  using namespace windows;
 
-  SDL_Surface* img = SDL_LoadBMP(filename.c_str());
+  if (!image.open(context.renderer(), asset)) return false;
 
-  if (img == NULL) {
-    std::cout << '\n' << SDL_GetError();
+  // the whole image to start with, as the stretched bitmap used to be,
+  // unless that needs more tiles than the budget holds
+  view = SDL_Rect{0, 0, image.getWidth(), image.getHeight()};
+  while (!image.fitsBudget(view.w, view.h) && (view.w > 1 || view.h > 1)) {
+    view.w = std::max(view.w / 2, 1);
+    view.h = std::max(view.h / 2, 1);
   }
-
-  // convert the loaded img to screensurface format to avoid redundant blitting
-  optimizedSurface = SDL_ConvertSurface(img, windows::windowSurface->format, 0);
-
-  // delete the unoptimized surface
-  SDL_FreeSurface(img);
-
-  return optimizedSurface;
+  return true;
 }
@@ -1,10 +1,12 @@
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 
 #include <iostream>
 #include <string>
 
-SDL_Window* g_mainWindow{nullptr};
+#include "assets.h"
+#include "context.h"
+#include "handles.h"
+#include "media.h"
 
 namespace parameters {
 constexpr int width{800};
@@ -12,13 +14,13 @@ constexpr int height{600};
 }  // namespace parameters
 
 namespace surface {
-SDL_Surface* mainSurface{nullptr};
-SDL_Surface* imgSurface{nullptr};  // back buffer image
+// the window, defined first so it is destroyed last
+engine::Context context;
+engine::SurfaceHandle imgSurface;  // back buffer image
 }  // namespace surface
 
-void close();
 bool init();
-SDL_Surface* loadSurface(std::string path);
+engine::SurfaceHandle loadSurface(engine::AssetId asset);
 bool loadMedia();
 
 int main(int argc, char* argv[]) {
@@ -28,8 +30,9 @@ int main(int argc, char* argv[]) {
     if (!loadMedia()) {
       std::cerr << "ERROR LOADING MEDIA\n";
     } else {
-      SDL_BlitSurface(surface::imgSurface, NULL, surface::mainSurface, NULL);
-      SDL_UpdateWindowSurface(g_mainWindow);
+      using namespace surface;
+      SDL_BlitSurface(imgSurface.get(), NULL, context.windowSurface(), NULL);
+      SDL_UpdateWindowSurface(context.window());
 
       // Hack to get window to stay up
       SDL_Event e;
@@ -41,71 +44,31 @@ int main(int argc, char* argv[]) {
       }
     }
   }
-  close();
   return 0;
 }
 
 bool loadMedia() {
-  bool isSuccess{true};
-
   // try to open the image
-  surface::imgSurface = loadSurface("../img/4default.png");
-
-  if (surface::imgSurface == NULL) {
-    std::cerr << SDL_GetError() << '\n';
-    isSuccess = false;
-  }
+  surface::imgSurface = loadSurface(assets::defaultImage);
 
-  return isSuccess;
+  return surface::imgSurface != nullptr;
 }
 
-SDL_Surface* loadSurface(std::string path) {
-  SDL_Surface* optimized {nullptr};
-
-  SDL_Surface* temp {IMG_Load(path.c_str())};
-  if(temp == nullptr){
-    std::cerr << '\n' << IMG_GetError();  
-  } else {
-    optimized = SDL_ConvertSurface(temp, surface::mainSurface->format, 0);
-    SDL_FreeSurface(temp);
-  }
-  return optimized;
-}
-
-void close() {
-  // delete main window
-  SDL_DestroyWindow(g_mainWindow);
-
-  // delete image surface
-  SDL_FreeSurface(surface::imgSurface);
+engine::SurfaceHandle loadSurface(engine::AssetId asset) {
+  engine::SurfaceHandle temp{engine::loadImage(asset)};
 
-  // de initalize the SDL
-  SDL_Quit();
+  // convert to the window format to avoid converting on every blit
+  return engine::convertSurface(temp.get(),
+                                surface::context.windowSurface()->format);
 }
 
 bool init() {
-  bool isSuccess{false};
-
-  // initialize the SDL
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cerr << "\n" << SDL_GetError();
-  } else {
-    // make window
-    g_mainWindow = SDL_CreateWindow("Test", SDL_WINDOWPOS_UNDEFINED,
-                                    SDL_WINDOWPOS_UNDEFINED, parameters::width,
-                                    parameters::height, SDL_WINDOW_SHOWN);
-  }
-
-  if (g_mainWindow == NULL) {
-    std::cerr << "\n" << SDL_GetError();
-  } else {
-    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-      std::cerr << "\n" << SDL_GetError();
-    } else {
-      surface::mainSurface = SDL_GetWindowSurface(g_mainWindow);
-      isSuccess = true;
-    }
-  }
-
-  return isSuccess;
+  engine::ContextConfig config;
+  config.title = "Test";
+  config.width = parameters::width;
+  config.height = parameters::height;
+  config.subsystems = engine::subsystem_image;
+  config.createRenderer = false;
+
+  return surface::context.init(config);
 }
@@ -1,75 +1,55 @@
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
-#include <SDL2/SDL_ttf.h>
 
-#include <cmath>
 #include <iostream>
 #include <string>
 
+#include "assets.h"
+#include "atlas.h"
+#include "benchmark.h"
+#include "button.h"
+#include "context.h"
+#include "handles.h"
+#include "media.h"
+#include "spriteBatch.h"
+#include "spriteSheet.h"
+
 bool init();
 bool loadMedia();
-void close();
+void scriptInput();
 
 namespace parameters {
 constexpr int width{800};
 constexpr int height{800};
-constexpr int buttonwidth{300};
-constexpr int buttonHeight{200};
 constexpr int buttonCount{4};
 }  // namespace parameters
 
-enum buttonSprite { mouse_out, mouse_over, mouse_down, mouse_up, mouse_max };
-
-class Texture {
- public:
-  Texture();
-  ~Texture();
-  void deallocate();
-
-  void render(int x, int y, SDL_Rect* clip = nullptr, double angle = 0.0,
-              SDL_Point* centre = nullptr,
-              SDL_RendererFlip flip = SDL_FLIP_NONE);
-
-  bool loadFile(std::string path);
-
-  bool loadText(std::string text, SDL_Color& color);
-
-  // getters
-  int getLength() { return m_height; }
-  int getBreadth() { return m_width; }
+namespace data {
+// defined first so it is destroyed after everything loaded through it
+engine::Context context;
+engine::SpriteBatch batch;
 
- private:
-  bool createTextureFromSurface(SDL_Surface* surf);
-  SDL_Texture* m_texture{nullptr};
-  int m_height{};
-  int m_width{};
-};
+// only active when run with --benchmark <frames>
+engine::FrameBenchmark benchmark;
 
-class Button {
- public:
-  Button();
-  void render();
-  void setPosition(int x, int y);
-  void handleEvent(SDL_Event* e);
+// animation, buttons and static text share one atlas page
+engine::Atlas atlas;
+int animationId{-1};
+int buttonId{-1};
+int textId{-1};
 
- private:
-  SDL_Point m_position{};
-  buttonSprite m_sprite{};
-};
+// frame rectangles, compiled from ../sheets/*.sheet
+engine::SpriteSheet walkFrames;
+engine::SpriteSheet buttonFrames;
 
-namespace data {
-SDL_Window* mainWindow{nullptr};
-SDL_Renderer* mainRenderer{nullptr};
 SDL_Rect sprites[4];
-Texture animation;
 constexpr int totalFrames{4};
 
-TTF_Font* mainFont{nullptr};
-Texture text;
+engine::FontHandle mainFont;
 
-SDL_Rect buttonSprites[4];
-Texture button;
-Button buttons[4];
+SDL_Rect buttonSprites[engine::mouse_max];
+int buttonwidth{};
+int buttonHeight{};
+engine::Button buttons[4];
 }  // namespace data
 
 void mouseEventHandler(SDL_Event& event, double& degrees,
@@ -122,6 +102,8 @@ void keyEventHandle(SDL_Event& event, int& x, int& y) {
 }
 
 int main(int argc, char* argv[]) {
+  bool scripted{data::benchmark.parse(argc, argv)};
+
   if (!init()) {
     std::cerr << "INITIALIZATION FAILURE.\n\n";
     return -1;
@@ -132,6 +114,9 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
+  // the script clicks the buttons, whose size comes from their sheet
+  if (scripted) scriptInput();
+
   SDL_Event event;
   bool quit{false};
 
@@ -147,7 +132,7 @@ int main(int argc, char* argv[]) {
   int x{parameters::width / 2 - 80};
   int y{parameters::height / 2 - 80};
 
-  while (!quit) {
+  while (!quit && data::benchmark.nextFrame(data::context.window())) {
     using namespace data;
     SDL_Rect* current{&sprites[frame / 4]};
     while (SDL_PollEvent(&event) != 0) {
@@ -166,247 +151,125 @@ int main(int argc, char* argv[]) {
       }
     }
 
-    SDL_SetRenderDrawColor(mainRenderer, 0xff, 0xff, 0xff, 0xff);
-    SDL_RenderClear(mainRenderer);
+    SDL_SetRenderDrawColor(context.renderer(), 0xff, 0xff, 0xff, 0xff);
+    SDL_RenderClear(context.renderer());
 
-    animation.render(x, y, current, degrees, nullptr, flipType);
-    text.render(x + 80, y + 80, nullptr, degrees, nullptr, SDL_FLIP_NONE);
+    batch.draw(atlas.texture(animationId), x, y, current, degrees, nullptr,
+               flipType);
+    batch.draw(atlas.texture(textId), x + 80, y + 80,
+               &atlas.region(textId).rect, degrees, nullptr, SDL_FLIP_NONE);
 
     for (int i{0}; i < parameters::buttonCount; i++) {
-      buttons[i].render();
+      buttons[i].render(batch);
     }
 
-    SDL_RenderPresent(mainRenderer);
+    batch.flush();
+    SDL_RenderPresent(context.renderer());
     frame++;
     if (frame / 4 >= totalFrames) frame = 0;
   }
 
-  close();
+  if (data::benchmark.enabled()) data::benchmark.report(std::cout);
   return 0;
 }
 
-Texture::Texture() : m_texture{nullptr}, m_height{0}, m_width{0} {}
-Texture::~Texture() { deallocate(); }
-
-void Texture::deallocate() {
-  if (m_texture) {
-    SDL_DestroyTexture(m_texture);
-    m_texture = nullptr;
-  }
-}
-
-bool Texture::loadFile(std::string path) {
-  deallocate();
-
-  SDL_Surface* temp{IMG_Load(path.c_str())};
-
-  if (!temp) {
-    std::cerr << "Error loading temp surface: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  SDL_SetColorKey(temp, SDL_TRUE, SDL_MapRGB(temp->format, 0x00, 0xff, 0xff));
-
-  return createTextureFromSurface(temp);
-}
-
-void Texture::render(int x, int y, SDL_Rect* clip, double angle,
-                     SDL_Point* centre, SDL_RendererFlip flip) {
-  SDL_Rect renderRect{x, y, m_width, m_height};
-  if (clip) {
-    renderRect.w = clip->w;
-    renderRect.h = clip->h;
-  }
-  SDL_RenderCopyEx(data::mainRenderer, m_texture, clip, &renderRect, angle,
-                   centre, flip);
-}
-
-bool Texture::loadText(std::string text, SDL_Color& color) {
-  deallocate();
-  SDL_Color textCol{0xff, 0xff, 0xff};
-  SDL_Surface* temp{
-      TTF_RenderUTF8_Shaded(data::mainFont, text.c_str(), color, textCol)};
-
-  if (!temp) {
-    std::cerr << "Error creating text: " << TTF_GetError() << '\n';
-    return false;
-  }
-
-  return {createTextureFromSurface(temp)};
-}
-
-// private function
-bool Texture::createTextureFromSurface(SDL_Surface* temp) {
-  m_texture = SDL_CreateTextureFromSurface(data::mainRenderer, temp);
-
-  SDL_FreeSurface(temp);
-  temp = nullptr;
-
-  if (!m_texture) {
-    std::cerr << "Error loading texture: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  SDL_QueryTexture(m_texture, NULL, NULL, &m_width, &m_height);
-  return true;
-}
-
-Button::Button() {
-  m_position.x = 0;
-  m_position.y = 0;
-}
-
-void Button::setPosition(int x, int y) {
-  m_position.x = x;
-  m_position.y = y;
-}
-
-void Button::render() {
-  data::button.render(m_position.x, m_position.y,
-                      &data::buttonSprites[m_sprite]);
+// one pass over the buttons, every mouse action and the movement keys,
+// repeated for as long as the benchmark runs
+void scriptInput() {
+  engine::FrameBenchmark& benchmark{data::benchmark};
+  using namespace parameters;
+  using data::buttonwidth;
+  using data::buttonHeight;
+
+  benchmark.addMotion(0, buttonwidth / 2, buttonHeight / 2);
+  benchmark.addClick(10, buttonwidth / 2, buttonHeight / 2);
+  benchmark.addWheel(20, 1);
+  benchmark.addKey(30, SDLK_w);
+  benchmark.addKey(30, SDLK_d);
+  benchmark.addMotion(40, width - buttonwidth / 2, height - buttonHeight / 2);
+  benchmark.addClick(50, width - buttonwidth / 2, height - buttonHeight / 2,
+                     SDL_BUTTON_RIGHT);
+  benchmark.addWheel(60, -1);
+  benchmark.addKey(70, SDLK_s);
+  benchmark.addKey(70, SDLK_a);
+  benchmark.addMotion(90, width / 2, height / 2);
+  benchmark.addClick(100, width / 2, height / 2, SDL_BUTTON_MIDDLE);
 }
 
-void Button::handleEvent(SDL_Event* event) {
-  int x{}, y{};
-  SDL_GetMouseState(&x, &y);
-
-  if (x < m_position.x || x > m_position.x + parameters::buttonwidth ||
-      y < m_position.y || y > m_position.y + parameters::buttonHeight) {
-    m_sprite = mouse_out;
-    return;
-  }
 
-  switch (event->type) {
-    case SDL_MOUSEBUTTONDOWN:
-      m_sprite = mouse_down;
-      return;
-    case SDL_MOUSEBUTTONUP:
-      m_sprite = mouse_up;
-      return;
-    case SDL_MOUSEMOTION:
-      m_sprite = mouse_over;
-      return;
-  }
+bool init() {
+  engine::ContextConfig config;
+  config.title = "part_anim";
+  config.width = parameters::width;
+  config.height = parameters::height;
+  config.subsystems = engine::subsystem_image | engine::subsystem_ttf;
+  config.rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+  data::benchmark.configure(config);
+
+  return data::context.init(config);
 }
 
-bool init() {
+bool loadMedia() {
   using namespace data;
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cerr << "SDL Init Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  if (IMG_Init(IMG_INIT_PNG) < 0) {
-    std::cerr << "IMG Init Failure: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  if (TTF_Init() == -1) {
-    std::cerr << "TTF Init Failure: " << TTF_GetError() << '\n';
-    return false;
-  }
+  using namespace parameters;
 
-  mainWindow = SDL_CreateWindow("part_anim", SDL_WINDOWPOS_UNDEFINED,
-                                SDL_WINDOWPOS_UNDEFINED, parameters::width,
-                                parameters::height, SDL_WINDOW_SHOWN);
+  SDL_Renderer* renderer{context.renderer()};
+  batch.setRenderer(renderer);
 
-  if (mainWindow == NULL) {
-    std::cerr << "SDL Window Creation Failure: " << SDL_GetError() << '\n';
+  if (!walkFrames.loadFile(assets::animationSheet) ||
+      !buttonFrames.loadFile(assets::buttonSheet)) {
     return false;
   }
 
-  mainRenderer = SDL_CreateRenderer(
-      mainWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  animationId = atlas.addFile(assets::animation);
+  if (animationId < 0) return false;
 
-  if (mainRenderer == NULL) {
-    std::cerr << "SDL Renderer Creation Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
+  // load font
+  {
+    mainFont = engine::loadFont(assets::font, 28);
+    if (!mainFont) return false;
 
-  if (SDL_SetRenderDrawColor(mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF) != 0) {
-    std::cerr << "SDL RENDERER DRAW ERROR: " << SDL_GetError() << '\n';
-    return false;
+    SDL_Color textCol{0, 0, 0};
+    SDL_Color textBackground{0xff, 0xff, 0xff};
+    textId = atlas.addSurface(
+        "text", engine::renderText(mainFont.get(), "im stickman :D", textCol,
+                                   &textBackground));
+    if (textId < 0) return false;
   }
 
-  return true;
-}
+  buttonId = atlas.addFile(assets::button);
+  if (buttonId < 0) return false;
 
-bool loadMedia() {
-  using namespace data;
-  using namespace parameters;
+  // one upload for everything above, clips are then page relative
+  if (!atlas.build(renderer)) return false;
 
-  if (!animation.loadFile("../img/6_animation.png")) return false;
-
-  sprites[0].x = 0;
-  sprites[0].y = 0;
-  sprites[0].w = 64;
-  sprites[0].h = 205;
-
-  sprites[1].x = 64;
-  sprites[1].y = 0;
-  sprites[1].w = 64;
-  sprites[1].h = 205;
-
-  sprites[2].x = 128;
-  sprites[2].y = 0;
-  sprites[2].w = 64;
-  sprites[2].h = 205;
-
-  sprites[3].x = 192;
-  sprites[3].y = 0;
-  sprites[3].w = 64;
-  sprites[3].h = 205;
-
-  mainFont = TTF_OpenFont(
-      "C:/Users/HP/AppData/Local/Microsoft/Windows/Fonts/mononoki-Regular.ttf",
-      28);
-  if (!mainFont) {
-    std::cerr << "Error opening font: " << TTF_GetError() << '\n';
-    return -1;
+  for (int i{0}; i < totalFrames; i++) {
+    int id{walkFrames.findFrame("walk_" + std::to_string(i))};
+    if (id < 0) return false;
+    sprites[i] = atlas.clip(animationId, walkFrames.frame(id).rect);
   }
 
-  SDL_Color textCol{0, 0, 0};
-  if (!text.loadText("im stickman :D", textCol)) {
-    return -1;
-  };
+  // load buttons
+  {
+    const char* states[engine::mouse_max]{"out", "over", "down", "up"};
+    for (int i = 0; i < engine::mouse_max; ++i) {
+      int id{buttonFrames.findFrame(states[i])};
+      if (id < 0) return false;
+      buttonSprites[i] = atlas.clip(buttonId, buttonFrames.frame(id).rect);
+    }
+    buttonwidth = buttonSprites[engine::mouse_out].w;
+    buttonHeight = buttonSprites[engine::mouse_out].h;
 
-  if (!button.loadFile("../img/button.png")) return false;
+    for (int i = 0; i < buttonCount; ++i) {
+      buttons[i].setSprites(&atlas.texture(buttonId), buttonSprites);
+      buttons[i].setSize(buttonwidth, buttonHeight);
+    }
 
-  for (int i = 0; i < buttonCount; ++i) {
-    buttonSprites[i].x = 0;
-    buttonSprites[i].y = i * 200;
-    buttonSprites[i].w = buttonwidth;
-    buttonSprites[i].h = buttonHeight;
+    // Set buttons in corners
+    buttons[0].setPosition(0, 0);
+    buttons[1].setPosition(width - buttonwidth, 0);
+    buttons[2].setPosition(0, height - buttonHeight);
+    buttons[3].setPosition(width - buttonwidth, height - buttonHeight);
   }
-
-  // Set buttons in corners
-  buttons[0].setPosition(0, 0);
-  buttons[1].setPosition(width - buttonwidth, 0);
-  buttons[2].setPosition(0, height - buttonHeight);
-  buttons[3].setPosition(width - buttonwidth, height - buttonHeight);
-
   return true;
 }
-
-void close() {
-  using namespace data;
-
-  // delete texture
-  animation.deallocate();
-  text.deallocate();
-
-  // close font
-  TTF_CloseFont(mainFont);
-
-  // delete renderer
-  SDL_DestroyRenderer(mainRenderer);
-  mainRenderer = nullptr;
-
-  // delete window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
-
-  TTF_Quit();
-  IMG_Quit();
-  SDL_Quit();
-}
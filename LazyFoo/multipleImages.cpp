@@ -2,7 +2,12 @@
 
 #include <iostream>
 #include <string>
-#include <vector>
+
+#include "assets.h"
+#include "compositor.h"
+#include "context.h"
+#include "handles.h"
+#include "media.h"
 
 namespace parameters {
 constexpr int scrnWidth{800};
@@ -19,25 +24,22 @@ enum keyPressImageLink {
   keyPressLink_max
 };
 
-// window information pointers
+// window information
 namespace windowsData {
-// the main window to open
-SDL_Window* mainWindow{nullptr};
-// primary rendering surface
-SDL_Surface* mainSurf{nullptr};
+// the main window to open, defined first so it is destroyed last
+engine::Context context;
 // surface of the currently back buffered image
 SDL_Surface* imgSurf{nullptr};
 // synced array for keypress images
-SDL_Surface* keyPressImg[keyPressLink_max];
+engine::SurfaceHandle keyPressImg[keyPressLink_max];
+// redraws the window only when the shown image changes
+engine::Compositor compositor;
 
 }  // namespace windowsData
 
 // initialize the window
 bool initialize();
 
-// close the media and the window
-void close();
-
 // load all the image files
 bool loadMedia();
 
@@ -45,7 +47,7 @@ bool loadMedia();
 void updateImageSurf(const SDL_Event& event);
 
 // loads a specific image
-SDL_Surface* loadSurface(std::string&&);
+engine::SurfaceHandle loadSurface(engine::AssetId asset);
 
 int main(int argc, char* argv[]) {
   if (!initialize()) {
@@ -59,7 +61,8 @@ int main(int argc, char* argv[]) {
       bool quit{false};
       SDL_Event event;
       // set current window to default
-      windowsData::imgSurf = windowsData::keyPressImg[keyPressLink_default];
+      windowsData::imgSurf =
+          windowsData::keyPressImg[keyPressLink_default].get();
       // get events and loops
       while (!quit) {
         while (SDL_PollEvent(&event) != 0) {
@@ -71,72 +74,50 @@ int main(int argc, char* argv[]) {
           else if (event.type == SDL_KEYDOWN) {
             updateImageSurf(event);
           }
-          SDL_BlitSurface(windowsData::imgSurf, NULL, windowsData::mainSurf,
-                          NULL);
-          SDL_UpdateWindowSurface(windowsData::mainWindow);
         }
+        SDL_Rect area{0, 0, windowsData::imgSurf->w, windowsData::imgSurf->h};
+        windowsData::compositor.draw(windowsData::imgSurf, &area);
+        windowsData::compositor.present();
       }
     }
   }
-  close();
   return 0;
 }
 
 bool initialize() {
-  // success flag
-  bool isSuccess{false};
+  engine::ContextConfig config;
+  config.title = "UP DOWN LEFT RIGHT UWU";
+  config.width = parameters::scrnWidth;
+  config.height = parameters::scrnHeight;
+  config.windowFlags = 0;
+  config.createRenderer = false;
 
-  // attempt to initialize the VIDEO SDL
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cout << "Error initializing SDL Window: " << SDL_GetError();
-  }
-  // OK, Now attempt to draw the window
-  else {
-    using namespace windowsData;
-    using namespace parameters;
-    mainWindow =
-        SDL_CreateWindow("UP DOWN LEFT RIGHT UWU", SDL_WINDOWPOS_UNDEFINED,
-                         SDL_WINDOWPOS_UNDEFINED, scrnWidth, scrnHeight, 0);
-
-    // check if window creation was success
-    if (mainWindow == NULL) {
-      std::cout << "Error creating window: " << SDL_GetError();
-    }
-    // OK, Now make main window surface
-    else {
-      mainSurf = SDL_GetWindowSurface(mainWindow);
-      isSuccess = true;
-    }
-  }
-  return isSuccess;
-}
+  if (!windowsData::context.init(config)) return false;
 
-// loads a specific image and returns a pointer to its surface
-SDL_Surface* loadSurface(std::string&& path) {
-  SDL_Surface* loadedSurf = SDL_LoadBMP(path.c_str());
+  windowsData::compositor.setWindow(windowsData::context.window());
+  return true;
+}
 
-  // check if the surface has been loaded successfully
-  if (loadedSurf == NULL) {
-    std::cout << SDL_GetError() << '\n';
-  }
-  return loadedSurf;
+// loads a specific image
+engine::SurfaceHandle loadSurface(engine::AssetId asset) {
+  return engine::loadBMP(asset);
 }
 
 bool loadMedia() {
   // indicates if the operation is a success
   bool isSuccess{true};
 
-  std::string relativePath{"../img/"};
-  // all the file names we need
-  std::vector<std::string> fileNames{
-      "3default.bmp", "3up.bmp", "3down.bmp", "3right.bmp", "3left.bmp",
+  // all the images we need, in keyPressLink order
+  const engine::AssetId images[keyPressLink_max]{
+      assets::keysDefault, assets::keysUp,   assets::keysDown,
+      assets::keysRight,   assets::keysLeft,
   };
 
   // loads all the images and stores pointers unto the array
   for (size_t i = 0; i < keyPressLink_max; i++) {
-    windowsData::keyPressImg[i] = loadSurface(relativePath + fileNames[i]);
+    windowsData::keyPressImg[i] = loadSurface(images[i]);
     // check if current loading is failure
-    if (windowsData::keyPressImg[i] == NULL) {
+    if (!windowsData::keyPressImg[i]) {
       isSuccess = false;
     }
   }
@@ -149,39 +130,19 @@ void updateImageSurf(const SDL_Event& event) {
   using namespace windowsData;
   switch (event.key.keysym.sym) {
     case SDLK_UP:
-      imgSurf = keyPressImg[keyPressLink_up];
+      imgSurf = keyPressImg[keyPressLink_up].get();
       break;
     case SDLK_DOWN:
-      imgSurf = keyPressImg[keyPressLink_down];
+      imgSurf = keyPressImg[keyPressLink_down].get();
       break;
     case SDLK_LEFT:
-      imgSurf = keyPressImg[keyPressLink_left];
+      imgSurf = keyPressImg[keyPressLink_left].get();
       break;
     case SDLK_RIGHT:
-      imgSurf = keyPressImg[keyPressLink_right];
+      imgSurf = keyPressImg[keyPressLink_right].get();
       break;
     default:
-      imgSurf = keyPressImg[keyPressLink_default];
+      imgSurf = keyPressImg[keyPressLink_default].get();
       break;
   }
 }
-
-void close() {
-  using namespace windowsData;
-
-  // deallocate surface memory
-  imgSurf = nullptr;
-
-  // free all the images
-  for (size_t i = 0; i < keyPressLink_max; i++) {
-    SDL_FreeSurface(keyPressImg[i]);
-    keyPressImg[i] = nullptr;
-  }
-
-  // delete the main window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
-
-  // close the SDL
-  SDL_Quit();
-}
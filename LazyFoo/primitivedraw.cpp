@@ -2,8 +2,10 @@
 
 #include <iostream>
 
-SDL_Window* g_mainWin{nullptr};
-SDL_Renderer* g_mainRenderer{nullptr};
+#include "context.h"
+
+// the window and its renderer, defined first so it is destroyed last
+engine::Context g_context;
 
 namespace paramaters {
 int width{800};
@@ -12,16 +14,15 @@ int height{600};
 
 // initializes the SDL
 bool init();
-// closes the SDL
-void close();
 
 int main(int argc, char* argv[]) {
   if (!init()) {
     std::cerr << "INITIALIZATION ERROR.\n";
-    close();
     return -1;
   }
 
+  SDL_Renderer* g_mainRenderer{g_context.renderer()};
+
   SDL_Event event;
   bool quit{false};
   while (!quit) {
@@ -67,43 +68,10 @@ int main(int argc, char* argv[]) {
 }
 
 bool init() {
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cerr << "SDL Init Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  g_mainWin = SDL_CreateWindow("PRIMITIVE TEST", SDL_WINDOWPOS_UNDEFINED,
-                               SDL_WINDOWPOS_UNDEFINED, paramaters::width,
-                               paramaters::height, SDL_WINDOW_SHOWN);
-
-  if (g_mainWin == NULL) {
-    std::cerr << "SDL Window Creation Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  g_mainRenderer = SDL_CreateRenderer(g_mainWin, -1, SDL_RENDERER_ACCELERATED);
-
-  if (g_mainRenderer == NULL) {
-    std::cerr << "SDL Renderer Creation Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  if (SDL_SetRenderDrawColor(g_mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF) != 0) {
-    std::cerr << "SDL RENDERER DRAW ERROR: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  return true;
-}
-
-void close() {
-  // destroy renderer
-  SDL_DestroyRenderer(g_mainRenderer);
-  g_mainRenderer = nullptr;
-  // destroy window
-  SDL_DestroyWindow(g_mainWin);
-  g_mainWin = nullptr;
+  engine::ContextConfig config;
+  config.title = "PRIMITIVE TEST";
+  config.width = paramaters::width;
+  config.height = paramaters::height;
 
-  // exit sdl
-  SDL_Quit();
+  return g_context.init(config);
 }
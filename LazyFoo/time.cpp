@@ -1,95 +1,123 @@
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <cmath>
+#include <cstdio>
+#include <future>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
-namespace audio {
-
-enum effects {
-  soundEff_high,
-  soundEff_low,
-  soundEff_medium,
-  soundEff_scratch,
-  soundEff_max
-};
-
-Mix_Music* mainMusic{nullptr};
-
-std::vector<Mix_Chunk*> soundEffects;
-}  // namespace audio
+#include "assetLoader.h"
+#include "assets.h"
+#include "atlas.h"
+#include "audioMixer.h"
+#include "benchmark.h"
+#include "button.h"
+#include "context.h"
+#include "glyphAtlas.h"
+#include "handles.h"
+#include "media.h"
+#include "profiler.h"
+#include "renderQueue.h"
+#include "spriteBatch.h"
+#include "spriteSheet.h"
+#include "timestep.h"
 
 bool init();
 bool loadMedia();
-void close();
+void scriptInput();
 
 namespace parameters {
 constexpr int width{800};
 constexpr int height{800};
-constexpr int buttonwidth{300};
-constexpr int buttonHeight{200};
 constexpr int buttonCount{4};
-}  // namespace parameters
-
-enum buttonSprite { mouse_out, mouse_over, mouse_down, mouse_up, mouse_max };
 
-class Texture {
- public:
-  Texture();
-  ~Texture();
-  void deallocate();
-
-  void render(int x, int y, SDL_Rect* clip = nullptr, double angle = 0.0,
-              SDL_Point* centre = nullptr,
-              SDL_RendererFlip flip = SDL_FLIP_NONE);
+// simulation steps per second, independent of the display's refresh rate
+constexpr double updateRate{60.0};
+}  // namespace parameters
 
-  bool loadFile(std::string path);
+namespace data {
+// defined first so it is destroyed after everything loaded through it
+engine::Context context;
+engine::SpriteBatch batch;
+
+// only active when run with --benchmark <frames>
+engine::FrameBenchmark benchmark;
+
+// draws are sorted per layer so each texture is bound once a frame;
+// buttons go on top, as they were drawn last before the queue
+engine::RenderQueue queue;
+enum layer : Uint8 { layer_sprites, layer_text, layer_buttons };
+
+// animation, buttons and static text share one atlas page
+engine::Atlas atlas;
+int animationId{-1};
+int buttonId{-1};
+int textId{-1};
+
+// frame rectangles and the walk cycle, compiled from ../sheets/*.sheet
+engine::SpriteSheet walkFrames;
+engine::SpriteSheet buttonFrames;
+int walkAnimation{-1};
+// page relative clips, indexed like walkFrames' frames
+std::vector<SDL_Rect> sprites;
+
+SDL_Color textCol{0, 0, 0, 0xff};
+SDL_Color textBackground{0xff, 0xff, 0xff};
+engine::FontHandle mainFont;
+
+// the timer changes every frame, so it is drawn glyph by glyph
+engine::GlyphAtlas glyphs;
+
+SDL_Rect buttonSprites[engine::mouse_max];
+int buttonwidth{};
+int buttonHeight{};
+engine::Button buttons[4];
+}  // namespace data
 
-  bool loadText(std::string text, SDL_Color& color);
+namespace profiling {
+// F3 shows where each frame went, phases are exclusive of nested ones
+engine::Profiler profiler;
+const int events{
+    profiler.addPhase("events", SDL_Color{0x40, 0x90, 0xff, 0xff})};
+const int buttons{
+    profiler.addPhase("buttons", SDL_Color{0x40, 0xe0, 0xe0, 0xff})};
+const int update{
+    profiler.addPhase("update", SDL_Color{0xc0, 0x80, 0xff, 0xff})};
+const int text{profiler.addPhase("text", SDL_Color{0xff, 0xd0, 0x40, 0xff})};
+const int render{
+    profiler.addPhase("render", SDL_Color{0x60, 0xe0, 0x60, 0xff})};
+const int present{
+    profiler.addPhase("present", SDL_Color{0xff, 0x60, 0x60, 0xff})};
+
+constexpr SDL_Rect overlay{10, parameters::height - 230, 480, 220};
+}  // namespace profiling
 
-  // getters
-  int getLength() { return m_height; }
-  int getBreadth() { return m_width; }
+namespace audio {
 
- private:
-  bool createTextureFromSurface(SDL_Surface* surf);
-  SDL_Texture* m_texture{nullptr};
-  int m_height{};
-  int m_width{};
+enum effects {
+  soundEff_high,
+  soundEff_low,
+  soundEff_medium,
+  soundEff_scratch,
+  soundEff_max
 };
 
-class Button {
- public:
-  Button();
-  void render();
-  void setPosition(int x, int y);
-  void handleEvent(SDL_Event* e);
+// decoded ahead on its own thread, defined before the mixer reading it
+engine::MusicStream mainMusic;
 
- private:
-  SDL_Point m_position{};
-  buttonSprite m_sprite{};
-};
+// sounds are started from the event loop without taking the audio lock
+engine::AudioMixer mixer;
 
-namespace data {
-SDL_Window* mainWindow{nullptr};
-SDL_Renderer* mainRenderer{nullptr};
-SDL_Rect sprites[4];
-Texture animation;
-constexpr int totalFrames{4};
-
-SDL_Color textCol{0, 0, 0};
-TTF_Font* mainFont{nullptr};
-Texture text;
-Texture timeTexture;
-
-SDL_Rect buttonSprites[4];
-Texture button;
-Button buttons[4];
-}  // namespace data
+engine::VoiceId musicVoice{0};
+bool musicPaused{false};
+
+// mixer sound ids, in the order of the effects enum
+std::vector<int> soundEffects;
+}  // namespace audio
 
 void mouseEventHandler(SDL_Event& event, double& degrees,
                        SDL_RendererFlip& flipType, int& x, int& y) {
@@ -120,15 +148,18 @@ void mouseEventHandler(SDL_Event& event, double& degrees,
 }
 
 void music() {
-  if (!Mix_PlayingMusic()) {
-    Mix_PlayMusic(audio::mainMusic, -1);
+  using namespace audio;
+  if (!mixer.isPlaying(musicVoice)) {
+    musicVoice = mixer.playStream(mainMusic);
+    musicPaused = false;
     return;
   }
 
-  if (Mix_PausedMusic())
-    Mix_ResumeMusic();
+  musicPaused = !musicPaused;
+  if (musicPaused)
+    mixer.pause(musicVoice);
   else
-    Mix_PauseMusic();
+    mixer.resume(musicVoice);
 }
 
 void keyEventHandle(SDL_Event& event, int& x, int& y) {
@@ -149,29 +180,54 @@ void keyEventHandle(SDL_Event& event, int& x, int& y) {
       x = (x + dP < width) ? x + dP : 0;
       return;
     case SDLK_1:
-      Mix_PlayChannel(-1, soundEffects[soundEff_high], 0);
+      mixer.play(soundEffects[soundEff_high]);
       return;
     case SDLK_2:
-      Mix_PlayChannel(-1, soundEffects[soundEff_medium], 0);
+      mixer.play(soundEffects[soundEff_medium]);
       return;
     case SDLK_3:
-      Mix_PlayChannel(-1, soundEffects[soundEff_low], 0);
+      mixer.play(soundEffects[soundEff_low]);
       return;
     case SDLK_4:
-      Mix_PlayChannel(-1, soundEffects[soundEff_scratch], 0);
+      mixer.play(soundEffects[soundEff_scratch]);
       return;
     case SDLK_9:
       music();
       return;
     case SDLK_0:
-      Mix_HaltMusic();
+      mixer.stop(musicVoice);
+      musicVoice = 0;
+      mainMusic.rewind();
       return;
     default:
       return;
   }
 }
 
+// what the update step moves, kept for the last two updates so frames can
+// be drawn in between
+struct SceneState {
+  double x;
+  double y;
+  double degrees;
+};
+
+// wrapping to the other edge snaps instead of sliding across the screen
+SceneState blend(const SceneState& previous, const SceneState& latest,
+                 double alpha) {
+  SceneState drawn{latest};
+  if (std::abs(latest.x - previous.x) < parameters::width / 2 &&
+      std::abs(latest.y - previous.y) < parameters::height / 2) {
+    drawn.x = engine::interpolate(previous.x, latest.x, alpha);
+    drawn.y = engine::interpolate(previous.y, latest.y, alpha);
+  }
+  drawn.degrees = engine::interpolate(previous.degrees, latest.degrees, alpha);
+  return drawn;
+}
+
 int main(int argc, char* argv[]) {
+  bool scripted{data::benchmark.parse(argc, argv)};
+
   if (!init()) {
     std::cerr << "INITIALIZATION FAILURE.\n\n";
     return -1;
@@ -182,10 +238,14 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
+  // the script clicks the buttons, whose size comes from their sheet
+  if (scripted) scriptInput();
+
   SDL_Event event;
   bool quit{false};
 
-  int frame{0};
+  // drives the walk cycle, so it keeps pace with the updates
+  Uint64 updates{0};
 
   // Angle of rotation
   double degrees{};
@@ -197,263 +257,229 @@ int main(int argc, char* argv[]) {
   int x{parameters::width / 2 - 80};
   int y{parameters::height / 2 - 80};
 
+  // updates run at a fixed rate, frames are drawn between the last two
+  engine::FixedTimestep timestep{parameters::updateRate};
+  SceneState latest{static_cast<double>(x), static_cast<double>(y), degrees};
+  SceneState previous{latest};
+
   // timer
   Uint64 startTime{};
-  std::stringstream timeText;
+  char timeText[32];
 
-  while (!quit) {
+  while (!quit && data::benchmark.nextFrame(data::context.window())) {
     using namespace data;
-    SDL_Rect* current{&sprites[frame / 4]};
-    while (SDL_PollEvent(&event) != 0) {
-      if (event.type == SDL_QUIT) quit = true;
-
-      if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEWHEEL) {
-        mouseEventHandler(event, degrees, flipType, x, y);
+    using profiling::profiler;
+
+    {
+      engine::ProfileScope scope{profiler, profiling::events};
+      while (SDL_PollEvent(&event) != 0) {
+        if (event.type == SDL_QUIT) quit = true;
+        if (profiler.handleEvent(event)) continue;
+
+        if (event.type == SDL_MOUSEBUTTONDOWN ||
+            event.type == SDL_MOUSEWHEEL) {
+          mouseEventHandler(event, degrees, flipType, x, y);
+        }
+
+        if (event.type == SDL_KEYDOWN) {
+          if (event.key.keysym.sym == SDLK_RETURN) {
+            startTime = SDL_GetTicks64();
+          } else
+            keyEventHandle(event, x, y);
+        }
+
+        engine::ProfileScope buttonScope{profiler, profiling::buttons};
+        for (int i{0}; i < parameters::buttonCount; i++) {
+          buttons[i].handleEvent(&event);
+        }
       }
-
-      if (event.type == SDL_KEYDOWN) {
-        if (event.key.keysym.sym == SDLK_RETURN) {
-          startTime = SDL_GetTicks64();
-        } else
-          keyEventHandle(event, x, y);
-      }
-
-      for (int i{0}; i < parameters::buttonCount; i++) {
-        buttons[i].handleEvent(&event);
+    }
+    audio::mainMusic.update();
+
+    {
+      engine::ProfileScope scope{profiler, profiling::update};
+      for (int steps{timestep.advance()}; steps > 0; steps--) {
+        previous = latest;
+        latest = SceneState{static_cast<double>(x), static_cast<double>(y),
+                            degrees};
+        updates++;
       }
     }
 
-    timeText.str("");
-    timeText << SDL_GetTicks64() - startTime << " ms passed.";
-    timeTexture.loadText(timeText.str().c_str(), textCol);
+    Uint32 animationTime{static_cast<Uint32>(
+        updates * 1000 / static_cast<Uint64>(parameters::updateRate))};
+    int current{walkFrames.frameAt(walkAnimation, animationTime)};
+    SceneState drawn{blend(previous, latest, timestep.getAlpha())};
+    int drawX{static_cast<int>(drawn.x)};
+    int drawY{static_cast<int>(drawn.y)};
+
+    {
+      engine::ProfileScope scope{profiler, profiling::render};
+      SDL_SetRenderDrawColor(context.renderer(), 0xff, 0xff, 0xff, 0xff);
+      SDL_RenderClear(context.renderer());
 
-    SDL_SetRenderDrawColor(mainRenderer, 0xff, 0xff, 0xff, 0xff);
-    SDL_RenderClear(mainRenderer);
+      const SDL_Color white{0xff, 0xff, 0xff, 0xff};
 
-    animation.render(x, y, current, degrees, nullptr, flipType);
-    text.render(x + 80, y + 80, nullptr, degrees, nullptr, SDL_FLIP_NONE);
-    timeTexture.render(x + 90, y + 10, nullptr, degrees, nullptr,
-                       SDL_FLIP_NONE);
+      // text goes over the moving sprite, the buttons over everything
+      for (int i{0}; i < parameters::buttonCount; i++) {
+        buttons[i].render(queue, layer_buttons);
+      }
+      queue.submit(layer_sprites, atlas.texture(animationId), drawX, drawY,
+                   &sprites[current], white, SDL_BLENDMODE_BLEND,
+                   drawn.degrees, &walkFrames.frame(current).pivot,
+                   flipType);
+      queue.submit(layer_text, atlas.texture(textId), drawX + 80, drawY + 80,
+                   &atlas.region(textId).rect, white, SDL_BLENDMODE_BLEND,
+                   drawn.degrees);
+
+      {
+        engine::ProfileScope textScope{profiler, profiling::text};
+        unsigned long long elapsed{SDL_GetTicks64() - startTime};
+        std::snprintf(timeText, sizeof(timeText), "%llu ms passed.",
+                      elapsed);
+        glyphs.draw(queue, layer_text, timeText, drawX + 90, drawY + 10,
+                    textCol, drawn.degrees);
+      }
 
-    for (int i{0}; i < parameters::buttonCount; i++) {
-      buttons[i].render();
+      queue.flush(batch);
+      profiler.render(context.renderer(), profiling::overlay, &batch,
+                      &glyphs);
     }
 
-    SDL_RenderPresent(mainRenderer);
-    frame++;
-    if (frame / 4 >= totalFrames) frame = 0;
+    {
+      engine::ProfileScope scope{profiler, profiling::present};
+      SDL_RenderPresent(context.renderer());
+    }
+    profiler.endFrame();
   }
 
-  close();
+  if (data::benchmark.enabled()) data::benchmark.report(std::cout);
   return 0;
 }
 
-Texture::Texture() : m_texture{nullptr}, m_height{0}, m_width{0} {}
-Texture::~Texture() { deallocate(); }
-
-void Texture::deallocate() {
-  if (m_texture) {
-    SDL_DestroyTexture(m_texture);
-    m_texture = nullptr;
-  }
-}
-
-bool Texture::loadFile(std::string path) {
-  deallocate();
-
-  SDL_Surface* temp{IMG_Load(path.c_str())};
-
-  if (!temp) {
-    std::cerr << "Error loading temp surface: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  SDL_SetColorKey(temp, SDL_TRUE, SDL_MapRGB(temp->format, 0x00, 0xff, 0xff));
-
-  return createTextureFromSurface(temp);
-}
-
-void Texture::render(int x, int y, SDL_Rect* clip, double angle,
-                     SDL_Point* centre, SDL_RendererFlip flip) {
-  SDL_Rect renderRect{x, y, m_width, m_height};
-  if (clip) {
-    renderRect.w = clip->w;
-    renderRect.h = clip->h;
-  }
-  SDL_RenderCopyEx(data::mainRenderer, m_texture, clip, &renderRect, angle,
-                   centre, flip);
-}
-
-bool Texture::loadText(std::string text, SDL_Color& color) {
-  deallocate();
-  SDL_Color textCol{0xff, 0xff, 0xff};
-  SDL_Surface* temp{
-      TTF_RenderUTF8_Shaded(data::mainFont, text.c_str(), color, textCol)};
-
-  if (!temp) {
-    std::cerr << "Error creating text: " << TTF_GetError() << '\n';
-    return false;
-  }
-
-  return {createTextureFromSurface(temp)};
-}
-
-// private function
-bool Texture::createTextureFromSurface(SDL_Surface* temp) {
-  m_texture = SDL_CreateTextureFromSurface(data::mainRenderer, temp);
-
-  SDL_FreeSurface(temp);
-  temp = nullptr;
-
-  if (!m_texture) {
-    std::cerr << "Error loading texture: " << IMG_GetError() << '\n';
-    return false;
-  }
-
-  SDL_QueryTexture(m_texture, NULL, NULL, &m_width, &m_height);
-  return true;
-}
-
-Button::Button() {
-  m_position.x = 0;
-  m_position.y = 0;
-}
-
-void Button::setPosition(int x, int y) {
-  m_position.x = x;
-  m_position.y = y;
-}
-
-void Button::render() {
-  data::button.render(m_position.x, m_position.y,
-                      &data::buttonSprites[m_sprite]);
+// one pass over the buttons, every mouse action and the movement keys,
+// repeated for as long as the benchmark runs
+void scriptInput() {
+  engine::FrameBenchmark& benchmark{data::benchmark};
+  using namespace parameters;
+  using data::buttonwidth;
+  using data::buttonHeight;
+
+  benchmark.addMotion(0, buttonwidth / 2, buttonHeight / 2);
+  benchmark.addClick(10, buttonwidth / 2, buttonHeight / 2);
+  benchmark.addWheel(20, 1);
+  benchmark.addKey(30, SDLK_w);
+  benchmark.addKey(30, SDLK_d);
+  benchmark.addMotion(40, width - buttonwidth / 2, height - buttonHeight / 2);
+  benchmark.addClick(50, width - buttonwidth / 2, height - buttonHeight / 2,
+                     SDL_BUTTON_RIGHT);
+  benchmark.addWheel(60, -1);
+  benchmark.addKey(70, SDLK_s);
+  benchmark.addKey(70, SDLK_a);
+  benchmark.addKey(80, SDLK_RETURN);
+  benchmark.addMotion(90, width / 2, height / 2);
+  benchmark.addClick(100, width / 2, height / 2, SDL_BUTTON_MIDDLE);
 }
 
-void Button::handleEvent(SDL_Event* event) {
-  int x{}, y{};
-  SDL_GetMouseState(&x, &y);
-
-  if (x < m_position.x || x > m_position.x + parameters::buttonwidth ||
-      y < m_position.y || y > m_position.y + parameters::buttonHeight) {
-    m_sprite = mouse_out;
-    return;
-  }
 
-  switch (event->type) {
-    case SDL_MOUSEBUTTONDOWN:
-      m_sprite = mouse_down;
-      return;
-    case SDL_MOUSEBUTTONUP:
-      m_sprite = mouse_up;
-      return;
-    case SDL_MOUSEMOTION:
-      m_sprite = mouse_over;
-      return;
-  }
+bool init() {
+  engine::ContextConfig config;
+  config.title = "part_anim";
+  config.width = parameters::width;
+  config.height = parameters::height;
+  config.subsystems =
+      engine::subsystem_image | engine::subsystem_ttf | engine::subsystem_mixer;
+  config.rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+  data::benchmark.configure(config);
+
+  return data::context.init(config);
 }
 
-bool init() {
+bool loadMedia() {
   using namespace data;
+  using namespace parameters;
 
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-    std::cerr << "Error initializing sdl: " << SDL_GetError() << '\n';
-    return false;
-  }
-
-  if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-    std::cerr << "Error initializing img: " << IMG_GetError() << '\n';
+  SDL_Renderer* renderer{context.renderer()};
+  batch.setRenderer(renderer);
+
+  // everything is decoded on worker threads at once, the window title
+  // shows how far along it is
+  engine::AssetLoader loader;
+  loader.setProgressCallback([](int finished, int total) {
+    std::string title{"part_anim - loading " + std::to_string(finished) +
+                      "/" + std::to_string(total)};
+    SDL_SetWindowTitle(context.window(), title.c_str());
+  });
+
+  // the indices are small enough to read before anything else starts
+  if (!walkFrames.loadFile(assets::animationSheet) ||
+      !buttonFrames.loadFile(assets::buttonSheet)) {
     return false;
   }
-
-  if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-    std::cerr << "Error initializing mixer: " << Mix_GetError() << '\n';
-    return false;
+  walkAnimation = walkFrames.findAnimation("walk");
+  if (walkAnimation < 0) return false;
+
+  std::future<engine::SurfaceHandle> animation{
+      loader.loadImage(engine::AssetId{walkFrames.getImage()})};
+  std::future<engine::SurfaceHandle> button{
+      loader.loadImage(engine::AssetId{buttonFrames.getImage()})};
+  std::future<engine::FontHandle> font{
+      loader.loadFont(assets::font, 28)};
+
+  std::vector<std::future<engine::ChunkHandle>> effects;
+  for (const engine::AssetId& effect :
+       {assets::high, assets::low, assets::medium, assets::scratch}) {
+    effects.push_back(loader.loadChunk(effect));
   }
 
-  if (TTF_Init() == -1) {
-    std::cerr << "TTF Init Failure: " << TTF_GetError() << '\n';
-    return false;
-  }
+  loader.finish();
+  SDL_SetWindowTitle(context.window(), "part_anim");
 
-  mainWindow = SDL_CreateWindow("part_anim", SDL_WINDOWPOS_UNDEFINED,
-                                SDL_WINDOWPOS_UNDEFINED, parameters::width,
-                                parameters::height, SDL_WINDOW_SHOWN);
+  // workers only decode, the sheets still need their cyan keyed out
+  engine::SurfaceHandle animationSheet{engine::applyColorKey(animation.get())};
+  engine::SurfaceHandle buttonSheet{engine::applyColorKey(button.get())};
+  if (!animationSheet || !buttonSheet) return false;
 
-  if (mainWindow == NULL) {
-    std::cerr << "SDL Window Creation Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
+  animationId = atlas.addSurface("6_animation", std::move(animationSheet));
+  if (animationId < 0) return false;
 
-  mainRenderer = SDL_CreateRenderer(
-      mainWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  // load font
+  {
+    mainFont = font.get();
+    if (!mainFont) return false;
 
-  if (mainRenderer == NULL) {
-    std::cerr << "SDL Renderer Creation Failure: " << SDL_GetError() << '\n';
-    return false;
-  }
+    if (!glyphs.load(renderer, mainFont.get())) return false;
 
-  if (SDL_SetRenderDrawColor(mainRenderer, 0xFF, 0xFF, 0xFF, 0xFF) != 0) {
-    std::cerr << "SDL RENDERER DRAW ERROR: " << SDL_GetError() << '\n';
-    return false;
+    textId = atlas.addSurface(
+        "text", engine::renderText(mainFont.get(), "Enter to reset timer",
+                                   textCol, &textBackground));
+    if (textId < 0) return false;
   }
 
-  return true;
-}
+  buttonId = atlas.addSurface("button", std::move(buttonSheet));
+  if (buttonId < 0) return false;
 
-bool loadMedia() {
-  using namespace data;
-  using namespace parameters;
-
-  // load animation
-  {
-    if (!animation.loadFile("../img/6_animation.png")) return false;
-
-    sprites[0].x = 0;
-    sprites[0].y = 0;
-    sprites[0].w = 64;
-    sprites[0].h = 205;
-
-    sprites[1].x = 64;
-    sprites[1].y = 0;
-    sprites[1].w = 64;
-    sprites[1].h = 205;
-
-    sprites[2].x = 128;
-    sprites[2].y = 0;
-    sprites[2].w = 64;
-    sprites[2].h = 205;
-
-    sprites[3].x = 192;
-    sprites[3].y = 0;
-    sprites[3].w = 64;
-    sprites[3].h = 205;
-  }
-
-  // load font
-  {
-    mainFont = TTF_OpenFont(
-        "C:/Users/HP/AppData/Local/Microsoft/Windows/Fonts/"
-        "mononoki-Regular.ttf",
-        28);
-    if (!mainFont) {
-      std::cerr << "Error opening font: " << TTF_GetError() << '\n';
-      return -1;
-    }
+  // one upload for everything above, clips are then page relative
+  if (!atlas.build(renderer)) return false;
 
-    if (!text.loadText("Enter to reset timer", textCol)) {
-      return -1;
-    };
+  for (int i{0}; i < walkFrames.getFrameCount(); i++) {
+    sprites.push_back(atlas.clip(animationId, walkFrames.frame(i).rect));
   }
 
   // load buttons
   {
-    if (!button.loadFile("../img/button.png")) return false;
+    const char* states[engine::mouse_max]{"out", "over", "down", "up"};
+    for (int i = 0; i < engine::mouse_max; ++i) {
+      int id{buttonFrames.findFrame(states[i])};
+      if (id < 0) return false;
+      buttonSprites[i] = atlas.clip(buttonId, buttonFrames.frame(id).rect);
+    }
+    buttonwidth = buttonSprites[engine::mouse_out].w;
+    buttonHeight = buttonSprites[engine::mouse_out].h;
 
     for (int i = 0; i < buttonCount; ++i) {
-      buttonSprites[i].x = 0;
-      buttonSprites[i].y = i * 200;
-      buttonSprites[i].w = buttonwidth;
-      buttonSprites[i].h = buttonHeight;
+      buttons[i].setSprites(&atlas.texture(buttonId), buttonSprites);
+      buttons[i].setSize(buttonwidth, buttonHeight);
     }
 
     // Set buttons in corners
@@ -467,59 +493,14 @@ bool loadMedia() {
   {
     using namespace audio;
 
-    mainMusic = Mix_LoadMUS("../sound/beat.wav");
-
-    std::string prefix{"../sound/"};
+    if (!mixer.open()) return false;
 
-    std::vector<std::string> effects{"high.wav", "low.wav", "medium.wav",
-                                     "scratch.wav"};
+    if (!mainMusic.open(assets::beat, mixer.getFrequency())) return false;
 
-    for (size_t i{0}; i < effects.size(); i++) {
-      std::string temp{prefix + effects[i]};
-      soundEffects.push_back(Mix_LoadWAV(temp.c_str()));
-      if (!soundEffects[i]) {
-        std::cerr << "Failed to load " << temp << "\n"
-                  << Mix_GetError() << '\n';
-        return false;
-      }
+    for (std::future<engine::ChunkHandle>& effect : effects) {
+      soundEffects.push_back(mixer.addSound(effect.get()));
+      if (soundEffects.back() < 0) return false;
     }
   }
   return true;
 }
-
-void close() {
-  using namespace data;
-  using namespace audio;
-
-  /* This function deletes all currently loaded
-  assets and sets all pointers to null */
-
-  // close music
-  Mix_FreeMusic(mainMusic);
-  mainMusic = nullptr;
-
-  for (auto i : soundEffects) {
-    Mix_FreeChunk(i);
-    i = nullptr;
-  }
-
-  // delete texture
-  animation.deallocate();
-  text.deallocate();
-  timeTexture.deallocate();
-
-  // close font
-  TTF_CloseFont(mainFont);
-
-  // delete renderer
-  SDL_DestroyRenderer(mainRenderer);
-  mainRenderer = nullptr;
-
-  // delete window
-  SDL_DestroyWindow(mainWindow);
-  mainWindow = nullptr;
-
-  TTF_Quit();
-  IMG_Quit();
-  SDL_Quit();
-}
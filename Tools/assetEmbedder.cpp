@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+bool readFile(const std::string& path, std::vector<char>& bytes) {
+  std::ifstream in{path, std::ios::binary | std::ios::ate};
+  if (!in) return false;
+
+  bytes.resize(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  return static_cast<bool>(in.read(bytes.data(), bytes.size()));
+}
+
+// same names AssetPack::normalize gives; this tool builds before the
+// engine, which contains its output, so it cannot link it
+std::string normalize(const std::string& path) {
+  std::string name{path};
+  std::replace(name.begin(), name.end(), '\\', '/');
+
+  for (;;) {
+    if (name.compare(0, 3, "../") == 0) {
+      name.erase(0, 3);
+    } else if (name.compare(0, 2, "./") == 0) {
+      name.erase(0, 2);
+    } else {
+      return name;
+    }
+  }
+}
+
+// hashPath from assetId.h over a normalized name, for the same reason
+std::uint64_t hashName(const std::string& name) {
+  std::uint64_t hash{0xcbf29ce484222325ull};
+  for (char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+struct Asset {
+  std::uint64_t id;
+  std::string name;
+  std::vector<char> bytes;
+};
+
+void writeBytes(std::ofstream& out, const std::vector<char>& bytes) {
+  char hex[8];
+  for (size_t i{0}; i < bytes.size(); i++) {
+    std::snprintf(hex, sizeof(hex), "0x%02x,",
+                  static_cast<unsigned char>(bytes[i]));
+    out << hex << ((i % 16 == 15) ? "\n" : "");
+  }
+}
+}  // namespace
+
+// writes a source file defining engine::embeddedAssetTable, see
+// embeddedAssets.h:
+//   assetEmbedder <output.cpp> [file]...
+// entries are named like asset pack entries and sorted by id for lookup,
+// and two names hashing to one id fail the build; with no files the table
+// is empty
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: assetEmbedder <output.cpp> [file]...\n";
+    return -1;
+  }
+
+  std::vector<Asset> assets;
+  for (int i{2}; i < argc; i++) {
+    std::vector<char> bytes;
+    if (!readFile(argv[i], bytes)) {
+      std::cerr << "Error reading " << argv[i] << '\n';
+      return -1;
+    }
+    std::string name{normalize(argv[i])};
+    assets.push_back(Asset{hashName(name), name, std::move(bytes)});
+  }
+
+  std::sort(assets.begin(), assets.end(),
+            [](const Asset& a, const Asset& b) { return a.id < b.id; });
+  for (size_t i{1}; i < assets.size(); i++) {
+    if (assets[i].id != assets[i - 1].id) continue;
+    if (assets[i].name == assets[i - 1].name) {
+      std::cerr << "Error: " << assets[i].name << " is listed twice\n";
+    } else {
+      std::cerr << "Error: " << assets[i].name << " and "
+                << assets[i - 1].name << " hash to the same asset id\n";
+    }
+    return -1;
+  }
+
+  std::ofstream out{argv[1], std::ios::binary | std::ios::trunc};
+  if (!out) {
+    std::cerr << "Error writing " << argv[1] << '\n';
+    return -1;
+  }
+
+  out << "// generated by assetEmbedder, do not edit\n"
+      << "#include \"embeddedAssets.h\"\n\n"
+      << "namespace engine {\n\nnamespace {\n";
+  for (size_t i{0}; i < assets.size(); i++) {
+    // one spare byte so empty files still make a valid array
+    out << "alignas(16) const unsigned char asset" << i << "[]{\n";
+    writeBytes(out, assets[i].bytes);
+    out << "0x00};\n";
+  }
+  out << "}  // namespace\n\n"
+      << "const EmbeddedAsset embeddedAssetTable[]{\n";
+  char id[32];
+  for (size_t i{0}; i < assets.size(); i++) {
+    std::snprintf(id, sizeof(id), "0x%016llxull",
+                  static_cast<unsigned long long>(assets[i].id));
+    out << "    {" << id << ", \"" << assets[i].name << "\", asset" << i
+        << ", " << assets[i].bytes.size() << "},\n";
+  }
+  out << "    {0, nullptr, nullptr, 0}};\n\n"
+      << "const size_t embeddedAssetCount{" << assets.size() << "};\n\n"
+      << "}  // namespace engine\n";
+
+  if (!out) {
+    std::cerr << "Error writing " << argv[1] << '\n';
+    return -1;
+  }
+
+  std::cout << "embedded " << assets.size() << " assets\n";
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <SDL2/SDL.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "assetPack.h"
+
+namespace {
+void writeU32(std::ofstream& out, Uint32 value) {
+  for (int i{0}; i < 4; i++) out.put(static_cast<char>(value >> (i * 8)));
+}
+
+void writeU64(std::ofstream& out, Uint64 value) {
+  for (int i{0}; i < 8; i++) out.put(static_cast<char>(value >> (i * 8)));
+}
+
+bool readFile(const std::string& path, std::vector<char>& bytes) {
+  std::ifstream in{path, std::ios::binary | std::ios::ate};
+  if (!in) return false;
+
+  bytes.resize(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  return static_cast<bool>(in.read(bytes.data(), bytes.size()));
+}
+
+Uint64 align(Uint64 offset) {
+  const Uint64 alignment{engine::AssetPack::alignment};
+  return (offset + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+// bundles asset files into one memory-mappable pack, see assetPack.h:
+//   assetPacker <output> <file>...
+// entries are named by their path as given, so run it from the directory
+// the programs' "../" paths point at (the repository root)
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "usage: assetPacker <output> <file>...\n";
+    return -1;
+  }
+
+  std::vector<std::string> names;
+  std::vector<std::vector<char>> contents;
+  for (int i{2}; i < argc; i++) {
+    std::vector<char> bytes;
+    if (!readFile(argv[i], bytes)) {
+      std::cerr << "Error reading " << argv[i] << '\n';
+      return -1;
+    }
+    names.push_back(engine::AssetPack::normalize(argv[i]));
+    contents.push_back(std::move(bytes));
+  }
+
+  // data starts after the index, so size the index first
+  Uint64 indexSize{sizeof(engine::AssetPack::magic) - 1 + 4};
+  for (const std::string& name : names) indexSize += 4 + name.size() + 16;
+
+  std::vector<Uint64> offsets;
+  Uint64 offset{align(indexSize)};
+  for (const std::vector<char>& bytes : contents) {
+    offsets.push_back(offset);
+    offset = align(offset + bytes.size());
+  }
+
+  std::ofstream out{argv[1], std::ios::binary};
+  if (!out) {
+    std::cerr << "Error writing " << argv[1] << '\n';
+    return -1;
+  }
+
+  out.write(engine::AssetPack::magic, sizeof(engine::AssetPack::magic) - 1);
+  writeU32(out, static_cast<Uint32>(names.size()));
+  for (size_t i{0}; i < names.size(); i++) {
+    writeU32(out, static_cast<Uint32>(names[i].size()));
+    out.write(names[i].data(), names[i].size());
+    writeU64(out, offsets[i]);
+    writeU64(out, contents[i].size());
+  }
+
+  for (size_t i{0}; i < contents.size(); i++) {
+    while (static_cast<Uint64>(out.tellp()) < offsets[i]) out.put('\0');
+    out.write(contents[i].data(), contents[i].size());
+  }
+
+  if (!out) {
+    std::cerr << "Error writing " << argv[1] << '\n';
+    return -1;
+  }
+
+  std::cout << "Packed " << names.size() << " file(s) into " << argv[1]
+            << '\n';
+  return 0;
+}
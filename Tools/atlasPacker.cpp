@@ -0,0 +1,48 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "atlas.h"
+
+// packs images into atlas pages ahead of time so programs skip packing:
+//   atlasPacker <output base> <page size> <image>...
+// writes <output base>_<n>.png and <output base>.atlas
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::cerr << "usage: atlasPacker <output base> <page size> <image>...\n";
+    return -1;
+  }
+
+  int pageSize{std::atoi(argv[2])};
+  if (pageSize <= 0) {
+    std::cerr << "Invalid page size: " << argv[2] << '\n';
+    return -1;
+  }
+
+  if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+    std::cerr << "Error initializing img: " << IMG_GetError() << '\n';
+    return -1;
+  }
+
+  int result{0};
+  {
+    engine::Atlas atlas{pageSize};
+
+    for (int i{3}; i < argc; i++) {
+      if (atlas.addFile(argv[i]) < 0) result = -1;
+    }
+
+    if (result == 0 && atlas.pack() && atlas.save(argv[1])) {
+      std::cout << "Packed " << atlas.getRegionCount() << " images into "
+                << atlas.getPageCount() << " page(s)\n";
+    } else {
+      result = -1;
+    }
+  }
+
+  IMG_Quit();
+  return result;
+}
@@ -0,0 +1,131 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "handles.h"
+#include "media.h"
+#include "tiledImage.h"
+
+namespace {
+bool writeU32(SDL_RWops* out, Uint32 value) {
+  value = SDL_SwapLE32(value);
+  return SDL_RWwrite(out, &value, sizeof(value), 1) == 1;
+}
+
+bool writeU64(SDL_RWops* out, Uint64 value) {
+  value = SDL_SwapLE64(value);
+  return SDL_RWwrite(out, &value, sizeof(value), 1) == 1;
+}
+
+struct Entry {
+  Uint64 offset;
+  Uint64 size;
+};
+
+// the tiles one after another, with the index written last once every
+// offset is known
+bool writeTiles(SDL_RWops* out, SDL_Surface* image, int tileSize) {
+  const int columns{(image->w + tileSize - 1) / tileSize};
+  const int rows{(image->h + tileSize - 1) / tileSize};
+
+  const size_t magicLength{sizeof(engine::TiledImage::magic) - 1};
+  if (SDL_RWwrite(out, engine::TiledImage::magic, magicLength, 1) != 1 ||
+      !writeU32(out, static_cast<Uint32>(image->w)) ||
+      !writeU32(out, static_cast<Uint32>(image->h)) ||
+      !writeU32(out, static_cast<Uint32>(tileSize))) {
+    return false;
+  }
+
+  const Sint64 indexStart{SDL_RWtell(out)};
+  std::vector<Entry> entries(static_cast<size_t>(columns) * rows);
+  for (const Entry& entry : entries) {
+    if (!writeU64(out, entry.offset) || !writeU64(out, entry.size)) {
+      return false;
+    }
+  }
+
+  // copied, not blended, so alpha survives as it is
+  SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+  for (int row{0}; row < rows; row++) {
+    for (int column{0}; column < columns; column++) {
+      SDL_Rect area{column * tileSize, row * tileSize, tileSize, tileSize};
+      area.w = std::min(area.w, image->w - area.x);
+      area.h = std::min(area.h, image->h - area.y);
+
+      engine::SurfaceHandle tile{SDL_CreateRGBSurfaceWithFormat(
+          0, area.w, area.h, 32, SDL_PIXELFORMAT_ARGB8888)};
+      if (!tile || SDL_BlitSurface(image, &area, tile.get(), nullptr) != 0) {
+        std::cerr << "Error cutting tile: " << SDL_GetError() << '\n';
+        return false;
+      }
+
+      Entry& entry{entries[row * columns + column]};
+      entry.offset = static_cast<Uint64>(SDL_RWtell(out));
+      if (IMG_SavePNG_RW(tile.get(), out, 0) != 0) {
+        std::cerr << "Error encoding tile: " << IMG_GetError() << '\n';
+        return false;
+      }
+      entry.size = static_cast<Uint64>(SDL_RWtell(out)) - entry.offset;
+    }
+  }
+
+  if (SDL_RWseek(out, indexStart, RW_SEEK_SET) < 0) return false;
+  for (const Entry& entry : entries) {
+    if (!writeU64(out, entry.offset) || !writeU64(out, entry.size)) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+// cuts an image into the tile file TiledImage streams from, see
+// tiledImage.h:
+//   imageTiler <image> <output.tiles> [tile size]
+// the image is decoded whole here, once, so programs never have to
+int main(int argc, char* argv[]) {
+  if (argc < 3 || argc > 4) {
+    std::cerr << "usage: imageTiler <image> <output.tiles> [tile size]\n";
+    return -1;
+  }
+
+  int tileSize{argc == 4 ? std::atoi(argv[3]) : 256};
+  if (tileSize <= 0) {
+    std::cerr << "Invalid tile size: " << argv[3] << '\n';
+    return -1;
+  }
+
+  if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+    std::cerr << "Error initializing img: " << IMG_GetError() << '\n';
+    return -1;
+  }
+
+  int result{-1};
+  {
+    engine::SurfaceHandle image{engine::loadImage(argv[1])};
+    if (image) {
+      image.reset(SDL_ConvertSurfaceFormat(image.get(),
+                                           SDL_PIXELFORMAT_ARGB8888, 0));
+    }
+
+    SDL_RWops* out{image ? SDL_RWFromFile(argv[2], "wb") : nullptr};
+    if (out) {
+      bool written{writeTiles(out, image.get(), tileSize)};
+      if (SDL_RWclose(out) == 0 && written) result = 0;
+    }
+
+    if (result == 0) {
+      std::cout << argv[2] << ": " << image->w << "x" << image->h << " in "
+                << tileSize << " pixel tiles\n";
+    } else {
+      std::cerr << "Error writing " << argv[2] << '\n';
+    }
+  }
+
+  IMG_Quit();
+  return result;
+}
@@ -0,0 +1,126 @@
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "mixOps.h"
+
+namespace {
+// the rate the Context opens the mixer at
+constexpr double frequency{44100.0};
+
+struct Voice {
+  std::vector<Sint16> samples;
+  float left;
+  float right;
+};
+
+// one buffer as the audio callback mixes it: every voice into the float
+// mix, then the mix onto the 16 bit output
+void mixBuffer(bool reference, const std::vector<Voice>& voices,
+               std::vector<float>& mix, std::vector<Sint16>& output,
+               int frames) {
+  std::fill(mix.begin(), mix.end(), 0.0f);
+  for (const Voice& voice : voices) {
+    if (reference) {
+      engine::mixVoiceReference(mix.data(), voice.samples.data(), frames,
+                                voice.left, voice.right);
+    } else {
+      engine::mixVoice(mix.data(), voice.samples.data(), frames, voice.left,
+                       voice.right);
+    }
+  }
+
+  std::fill(output.begin(), output.end(), Sint16{0});
+  if (reference) {
+    engine::saturateS16Reference(output.data(), mix.data(), output.size(),
+                                 0.25f);
+  } else {
+    engine::saturateS16(output.data(), mix.data(), output.size(), 0.25f);
+  }
+}
+
+// seconds per buffer, after one buffer to warm up
+double timeBuffers(bool reference, const std::vector<Voice>& voices,
+                   std::vector<float>& mix, std::vector<Sint16>& output,
+                   int frames, int buffers) {
+  mixBuffer(reference, voices, mix, output, frames);
+
+  const Uint64 start{SDL_GetPerformanceCounter()};
+  for (int i{0}; i < buffers; i++) {
+    mixBuffer(reference, voices, mix, output, frames);
+  }
+  const Uint64 elapsed{SDL_GetPerformanceCounter() - start};
+  return static_cast<double>(elapsed) / SDL_GetPerformanceFrequency() /
+         buffers;
+}
+
+void report(const char* path, double seconds, double period) {
+  std::cout << path << ": " << seconds * 1e6 << " us per buffer, "
+            << 100.0 * seconds / period << "% of the period\n";
+}
+}  // namespace
+
+// times the audio mixer's kernels on voices of noise:
+//   mixBench [voices=256] [buffer frames=2048] [buffers=200]
+// the vector path is checked against the scalar reference first, then
+// each is timed against how long one buffer plays for
+int main(int argc, char* argv[]) {
+  if (argc > 4) {
+    std::cerr << "usage: mixBench [voices] [buffer frames] [buffers]\n";
+    return -1;
+  }
+  const int voiceCount{argc > 1 ? std::atoi(argv[1]) : 256};
+  const int frames{argc > 2 ? std::atoi(argv[2]) : 2048};
+  const int buffers{argc > 3 ? std::atoi(argv[3]) : 200};
+  if (voiceCount <= 0 || frames <= 0 || buffers <= 0) {
+    std::cerr << "Invalid arguments, all three must be positive\n";
+    return -1;
+  }
+
+  // a fixed seed so runs compare like with like
+  std::mt19937 random{2024};
+  std::uniform_int_distribution<int> sample{-32768, 32767};
+  std::uniform_real_distribution<float> gain{0.0f, 1.0f};
+
+  std::vector<Voice> voices(voiceCount);
+  for (Voice& voice : voices) {
+    voice.samples.resize(static_cast<size_t>(frames) * 2);
+    for (Sint16& value : voice.samples) {
+      value = static_cast<Sint16>(sample(random));
+    }
+    voice.left = gain(random);
+    voice.right = gain(random);
+  }
+
+  std::vector<float> mix(static_cast<size_t>(frames) * 2);
+  std::vector<Sint16> output(mix.size());
+  std::vector<Sint16> expected(mix.size());
+
+  mixBuffer(true, voices, mix, expected, frames);
+  mixBuffer(false, voices, mix, output, frames);
+  if (std::memcmp(expected.data(), output.data(),
+                  output.size() * sizeof(Sint16)) != 0) {
+    std::cerr << "Error: the " << engine::mixOpsPath()
+              << " path differs from the scalar reference\n";
+    return -1;
+  }
+
+  const double period{frames / frequency};
+  std::cout << voiceCount << " voices, " << frames << " frame buffers ("
+            << period * 1e3 << " ms each)\n";
+
+  const double scalar{
+      timeBuffers(true, voices, mix, output, frames, buffers)};
+  report("scalar", scalar, period);
+
+  const double vector{
+      timeBuffers(false, voices, mix, output, frames, buffers)};
+  report(engine::mixOpsPath(), vector, period);
+  std::cout << "speedup: " << scalar / vector << "x\n";
+  return 0;
+}
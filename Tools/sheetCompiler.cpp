@@ -0,0 +1,22 @@
+#include <SDL2/SDL.h>
+
+#include <iostream>
+
+#include "spriteSheet.h"
+
+// compiles a text sprite sheet description into the binary index programs
+// load, see spriteSheet.h:
+//   sheetCompiler <input.sheet> <output.sprites>
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::cerr << "usage: sheetCompiler <input.sheet> <output.sprites>\n";
+    return -1;
+  }
+
+  engine::SpriteSheet sheet;
+  if (!sheet.parse(argv[1]) || !sheet.save(argv[2])) return -1;
+
+  std::cout << argv[2] << ": " << sheet.getFrameCount() << " frames, "
+            << sheet.getAnimationCount() << " animations\n";
+  return 0;
+}